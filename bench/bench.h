@@ -0,0 +1,187 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:27:09 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BENCH_H
+# define BENCH_H
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <unistd.h>
+# include <signal.h>
+# include <poll.h>
+# include <time.h>
+# include <sys/wait.h>
+# include <sys/resource.h>
+
+/**
+ * BENCH_LIST		Most values a sweep list (--philos=5,50,...) can hold
+ * BENCH_EXTRA		Most extra arguments passed to the binary (--args)
+ * BENCH_LINE		Longest line of output kept, the rest is cut
+ * BENCH_READ		How much output is read at once
+ * BENCH_POLL_MS	How often (ms) the timeout is checked while waiting
+*/
+# define BENCH_LIST 16
+# define BENCH_EXTRA 16
+# define BENCH_LINE 256
+# define BENCH_READ 65536
+# define BENCH_POLL_MS 100
+
+/* ====== STRUCTS ====== */
+
+/**
+ * @brief One point of the sweep
+ *
+ * @param philos	Number of philo
+ * @param die		Time to die in ms
+ * @param eat		Time to eat in ms
+ * @param sleep		Time to sleep in ms
+ * @param meals		Number of simulation
+ * @param argv		The same, as arguments for the binary
+*/
+typedef struct s_case
+{
+	int		philos;
+	int		die;
+	int		eat;
+	int		sleep;
+	int		meals;
+	char	argv[5][16];
+}		t_case;
+
+/**
+ * @brief A growing list of measures (ms)
+ *
+ * @param v		The measures
+ * @param total	Number of measures
+ * @param cap	Room for measures
+*/
+typedef struct s_series
+{
+	long	*v;
+	int		total;
+	int		cap;
+}		t_series;
+
+/**
+ * @brief What the output of a run says
+ *
+ * @param c			The point of the sweep
+ * @param meals		Meals eaten by each philo
+ * @param last		When each philo last started eating (ms)
+ * @param slept		When each philo last fell asleep (ms)
+ * @param gaps		Every time between two meals of a philo, the first
+ * 					one counted from the start, the last one up to his
+ * 					death if he died
+ * @param late		How much longer than asked every meal and nap took:
+ * 					the wake-up jitter
+ * @param eaten		Meals eaten in total
+ * @param died		When someone died (ms), -1 if nobody did
+ * @param line		The line being read
+ * @param line_len	Its length so far
+*/
+typedef struct s_stats
+{
+	t_case		*c;
+	long		*meals;
+	long		*last;
+	long		*slept;
+	t_series	gaps;
+	t_series	late;
+	long		eaten;
+	long		died;
+	char		line[BENCH_LINE];
+	int			line_len;
+}		t_stats;
+
+/**
+ * @brief A single run of the binary
+ *
+ * @param c			The point of the sweep
+ * @param stats		What its output says
+ * @param wall		Wall clock time (s)
+ * @param usage		CPU time and context switches, from wait4
+ * @param timed_out	Killed because it ran past --timeout
+ * @param status	Its exit status, 128 + the signal if one killed it.
+ * 					Anything but 0 (timeouts aside) is a failed run: exec
+ * 					failed (127), a crash, or an error
+*/
+typedef struct s_run
+{
+	t_case			c;
+	t_stats			stats;
+	double			wall;
+	struct rusage	usage;
+	int				timed_out;
+	int				status;
+}		t_run;
+
+/**
+ * @brief The benchmark settings
+ *
+ * @param bin			The binary (philo or philo_bonus)
+ * @param csv			Where results are appended
+ * @param tag			Label of the results, e.g. the commit
+ * @param extra			Extra arguments for the binary (--args)
+ * @param extra_total	Number of extra arguments
+ * @param philos		Philo counts to sweep
+ * @param philo_total	Number of philo counts
+ * @param times			die:eat:sleep triplets to sweep
+ * @param time_total	Number of triplets
+ * @param meals			Meal counts to sweep
+ * @param meal_total	Number of meal counts
+ * @param timeout		Longest a run may take (s)
+*/
+typedef struct s_bench
+{
+	char	*bin;
+	char	*csv;
+	char	*tag;
+	char	*extra[BENCH_EXTRA];
+	int		extra_total;
+	int		philos[BENCH_LIST];
+	int		philo_total;
+	int		times[BENCH_LIST][3];
+	int		time_total;
+	int		meals[BENCH_LIST];
+	int		meal_total;
+	double	timeout;
+}		t_bench;
+
+/* ====== FUNCTION PROTOTYPES ====== */
+
+// Options
+int		bench_parse(t_bench *bench, int ac, char **av);
+
+// Run
+int		bench_run(t_bench *bench, t_run *run);
+double	bench_now(void);
+
+// Output parsing
+void	bench_feed(t_stats *stats, char *buf, ssize_t len);
+
+// Series
+int		bench_series_init(t_series *series);
+void	bench_push(t_series *series, long value);
+void	bench_series_sort(t_series *series);
+long	bench_percentile(t_series *series, double q);
+
+// Stats
+int		bench_stats_init(t_stats *stats, t_case *c);
+void	bench_stats_sort(t_stats *stats);
+double	bench_jain(t_stats *stats);
+void	bench_stats_free(t_stats *stats);
+
+// CSV
+void	bench_report(t_bench *bench, t_run *run);
+
+#endif
@@ -0,0 +1,132 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_csv.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:27:09 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/**
+ * @brief Write the CSV header
+ * @param csv The CSV file
+*/
+static void	bench_csv_header(FILE *csv)
+{
+	fprintf(csv, "tag,binary,args,philos,die,eat,sleep,meals,timed_out,"
+		"exit_status,died_ms,wall_s,eaten,meals_per_s,jain,gap_p50_ms,"
+		"gap_p99_ms,gap_max_ms,gap_max_over_die,user_s,sys_s,nvcsw,nivcsw,"
+		"late_p99_ms,late_max_ms\n");
+}
+
+/**
+ * @brief Write the extra arguments as a single (quoted) CSV field
+ * @param csv The CSV file
+ * @param bench The benchmark settings
+*/
+static void	bench_csv_args(FILE *csv, t_bench *bench)
+{
+	int	i;
+
+	fputc('"', csv);
+	i = -1;
+	while (++i < bench->extra_total)
+	{
+		if (i > 0)
+			fputc(' ', csv);
+		fputs(bench->extra[i], csv);
+	}
+	fputc('"', csv);
+}
+
+/**
+ * @brief Write the row of a run
+ * @param csv The CSV file
+ * @param bench The benchmark settings
+ * @param run The run, series sorted
+*/
+static void	bench_csv_row(FILE *csv, t_bench *bench, t_run *run)
+{
+	struct rusage	*ru;
+
+	ru = &run->usage;
+	fprintf(csv, "%s,%s,", bench->tag, bench->bin);
+	bench_csv_args(csv, bench);
+	fprintf(csv, ",%d,%d,%d,%d,%d,%d,%d,%ld,%.3f,%ld,%.1f,%.4f,%ld,%ld,"
+		"%ld,%.3f,%.3f,%.3f,%ld,%ld,", run->c.philos, run->c.die, run->c.eat,
+		run->c.sleep, run->c.meals, run->timed_out, run->status,
+		run->stats.died,
+		run->wall, run->stats.eaten, run->stats.eaten / run->wall,
+		bench_jain(&run->stats), bench_percentile(&run->stats.gaps, 0.5),
+		bench_percentile(&run->stats.gaps, 0.99),
+		bench_percentile(&run->stats.gaps, 1),
+		(double)bench_percentile(&run->stats.gaps, 1) / run->c.die,
+		ru->ru_utime.tv_sec + ru->ru_utime.tv_usec / 1e6,
+		ru->ru_stime.tv_sec + ru->ru_stime.tv_usec / 1e6,
+		ru->ru_nvcsw, ru->ru_nivcsw);
+	fprintf(csv, "%ld,%ld\n", bench_percentile(&run->stats.late, 0.99),
+		bench_percentile(&run->stats.late, 1));
+}
+
+/**
+ * @brief Print a one line summary of a run
+ * @param run The run, series sorted
+*/
+static void	bench_print(t_run *run)
+{
+	struct rusage	*ru;
+
+	ru = &run->usage;
+	printf("%4d %4d:%d:%d x%-3d %9.1f meals/s  jain %.3f  gap %ld/%ld/%ldms"
+		"  late %ld/%ldms  cpu %.2fs  csw %ld", run->c.philos, run->c.die,
+		run->c.eat, run->c.sleep, run->c.meals, run->stats.eaten / run->wall,
+		bench_jain(&run->stats), bench_percentile(&run->stats.gaps, 0.5),
+		bench_percentile(&run->stats.gaps, 0.99),
+		bench_percentile(&run->stats.gaps, 1),
+		bench_percentile(&run->stats.late, 0.99),
+		bench_percentile(&run->stats.late, 1),
+		ru->ru_utime.tv_sec + ru->ru_stime.tv_sec
+		+ (ru->ru_utime.tv_usec + ru->ru_stime.tv_usec) / 1e6,
+		ru->ru_nvcsw + ru->ru_nivcsw);
+	if (run->stats.died >= 0)
+		printf("  died at %ldms", run->stats.died);
+	if (run->timed_out)
+		printf("  TIMED OUT");
+	else if (run->status != 0)
+		printf("  FAILED (exit %d)", run->status);
+	printf("\n");
+}
+
+/**
+ * @brief Report a run: append it to the CSV and print a summary
+ * @param bench The benchmark settings
+ * @param run The run
+ *
+ * @details
+ * The header is only written when the CSV is empty, so runs from
+ * several commits pile up in the same file. A failed run is written
+ * too, flagged by its exit_status, so that it shows up instead of
+ * passing for a run with no throughput.
+*/
+void	bench_report(t_bench *bench, t_run *run)
+{
+	FILE	*csv;
+
+	bench_stats_sort(&run->stats);
+	bench_print(run);
+	csv = fopen(bench->csv, "a");
+	if (csv == NULL)
+	{
+		perror(bench->csv);
+		return ;
+	}
+	if (ftell(csv) == 0)
+		bench_csv_header(csv);
+	bench_csv_row(csv, bench, run);
+	fclose(csv);
+}
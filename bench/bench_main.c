@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_main.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:27:09 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:27:50 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/**
+ * @brief Fill in the i-th point of the sweep
+ * @param bench The benchmark settings
+ * @param i Index of the point, philo counts varying the slowest
+ * @param c The point
+*/
+static void	bench_case(t_bench *bench, int i, t_case *c)
+{
+	int	*times;
+
+	c->meals = bench->meals[i % bench->meal_total];
+	i /= bench->meal_total;
+	times = bench->times[i % bench->time_total];
+	c->philos = bench->philos[i / bench->time_total];
+	c->die = times[0];
+	c->eat = times[1];
+	c->sleep = times[2];
+	snprintf(c->argv[0], sizeof(c->argv[0]), "%d", c->philos);
+	snprintf(c->argv[1], sizeof(c->argv[1]), "%d", c->die);
+	snprintf(c->argv[2], sizeof(c->argv[2]), "%d", c->eat);
+	snprintf(c->argv[3], sizeof(c->argv[3]), "%d", c->sleep);
+	snprintf(c->argv[4], sizeof(c->argv[4]), "%d", c->meals);
+}
+
+/**
+ * @brief Run every point of the sweep once
+ * @param bench The benchmark settings
+ *
+ * @details
+ * A run of the binary that failed doesn't stop the sweep, but the
+ * benchmark fails in the end.
+ *
+ * @return 1 if every run went through, 0 otherwise.
+*/
+static int	bench_sweep(t_bench *bench)
+{
+	t_run	run;
+	int		i;
+	int		total;
+	int		ok;
+
+	total = bench->philo_total * bench->time_total * bench->meal_total;
+	printf("%s %s (%d runs, results in %s)\n", bench->bin, bench->tag,
+		total, bench->csv);
+	ok = 1;
+	i = -1;
+	while (++i < total)
+	{
+		bench_case(bench, i, &run.c);
+		if (bench_run(bench, &run) == 0)
+		{
+			perror(bench->bin);
+			bench_stats_free(&run.stats);
+			return (0);
+		}
+		bench_report(bench, &run);
+		bench_stats_free(&run.stats);
+		if (run.status != 0 && run.timed_out == 0)
+			ok = 0;
+	}
+	return (ok);
+}
+
+/**
+ * @brief Benchmark philo or philo_bonus over a sweep of arguments
+ *
+ * usage: bench <binary> [--philos=5,50,200] [--times=die:eat:sleep,...]
+ *              [--meals=10,...] [--args="--fork=chandy ..."]
+ *              [--timeout=60] [--csv=bench.csv] [--tag=<commit>]
+*/
+int	main(int ac, char **av)
+{
+	t_bench	bench;
+
+	if (bench_parse(&bench, ac, av) == 0)
+	{
+		fprintf(stderr, "usage: %s <binary> [--philos=5,50,200] "
+			"[--times=800:200:200,...] [--meals=10,...] [--args=\"...\"] "
+			"[--timeout=60] [--csv=bench.csv] [--tag=...]\n", av[0]);
+		return (EXIT_FAILURE);
+	}
+	if (bench_sweep(&bench) == 0)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,162 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_option.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:27:09 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:27:50 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/**
+ * @brief Read a list of non negative numbers, e.g. "5,50,200"
+ * @param value The list
+ * @param list Where to store the numbers
+ * @param max Room in list
+ * @param sep What separates the numbers
+ *
+ * @return How many numbers were read, -1 if the list is invalid.
+*/
+static int	bench_ints(char *value, int *list, int max, char sep)
+{
+	int		total;
+	char	*end;
+
+	total = 0;
+	while (total < max)
+	{
+		list[total++] = strtol(value, &end, 10);
+		if (end == value || list[total - 1] < 0)
+			return (-1);
+		if (*end != sep)
+			break ;
+		value = end + 1;
+	}
+	if (*end != '\0')
+		return (-1);
+	return (total);
+}
+
+/**
+ * @brief Read the die:eat:sleep triplets, e.g. "800:200:200,410:200:200"
+ * @param bench The benchmark settings
+ * @param value The triplets (cut up in place)
+ *
+ * @return 1 if every triplet is valid, 0 otherwise.
+*/
+static int	bench_times(t_bench *bench, char *value)
+{
+	char	*next;
+
+	bench->time_total = 0;
+	while (value != NULL && bench->time_total < BENCH_LIST)
+	{
+		next = strchr(value, ',');
+		if (next != NULL)
+			*next++ = '\0';
+		if (bench_ints(value, bench->times[bench->time_total++], 3, ':') != 3)
+			return (0);
+		value = next;
+	}
+	return (value == NULL);
+}
+
+/**
+ * @brief Split the extra arguments on spaces, e.g. "--fork=chandy --report"
+ * @param bench The benchmark settings
+ * @param value The arguments (cut up in place)
+ *
+ * @return 1 on success, 0 if there are more than BENCH_EXTRA.
+*/
+static int	bench_args(t_bench *bench, char *value)
+{
+	bench->extra_total = 0;
+	while (*value != '\0')
+	{
+		while (*value == ' ')
+			*value++ = '\0';
+		if (*value == '\0')
+			break ;
+		if (bench->extra_total == BENCH_EXTRA)
+			return (0);
+		bench->extra[bench->extra_total++] = value;
+		while (*value != '\0' && *value != ' ')
+			value++;
+	}
+	return (1);
+}
+
+/**
+ * @brief Parse a single option
+ * @param bench The benchmark settings
+ * @param arg The option
+ *
+ * @return 1 if the option is known and its value valid, 0 otherwise.
+*/
+static int	bench_option(t_bench *bench, char *arg)
+{
+	if (strncmp(arg, "--philos=", 9) == 0)
+		bench->philo_total = bench_ints(arg + 9, bench->philos,
+				BENCH_LIST, ',');
+	else if (strncmp(arg, "--meals=", 8) == 0)
+		bench->meal_total = bench_ints(arg + 8, bench->meals,
+				BENCH_LIST, ',');
+	else if (strncmp(arg, "--times=", 8) == 0)
+		return (bench_times(bench, arg + 8));
+	else if (strncmp(arg, "--args=", 7) == 0)
+		return (bench_args(bench, arg + 7));
+	else if (strncmp(arg, "--timeout=", 10) == 0)
+		bench->timeout = atof(arg + 10);
+	else if (strncmp(arg, "--csv=", 6) == 0)
+		bench->csv = arg + 6;
+	else if (strncmp(arg, "--tag=", 6) == 0)
+		bench->tag = arg + 6;
+	else
+		return (0);
+	return (bench->philo_total > 0 && bench->meal_total > 0
+		&& bench->timeout > 0);
+}
+
+/**
+ * @brief Parse the command line
+ * @param bench The benchmark settings
+ * @param ac Argument count
+ * @param av Arguments: the binary, then options
+ *
+ * @details
+ * The default sweep is 5, 50 and 200 philos, each at 800:200:200 (easy)
+ * and 410:200:200 (10ms to spare), 10 meals each, one minute at most.
+ *
+ * @return 1 on success, 0 on error.
+*/
+int	bench_parse(t_bench *bench, int ac, char **av)
+{
+	char	times[64];
+	int		i;
+
+	memset(bench, 0, sizeof(t_bench));
+	strcpy(times, "--times=800:200:200,410:200:200");
+	bench->csv = "bench.csv";
+	bench->tag = "";
+	bench->timeout = 60;
+	bench_option(bench, "--philos=5,50,200");
+	bench_option(bench, "--meals=10");
+	bench_option(bench, times);
+	if (ac < 2)
+		return (0);
+	bench->bin = av[1];
+	i = 1;
+	while (++i < ac)
+	{
+		if (bench_option(bench, av[i]) == 0)
+		{
+			fprintf(stderr, "bench: invalid option: %s\n", av[i]);
+			return (0);
+		}
+	}
+	return (1);
+}
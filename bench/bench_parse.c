@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_parse.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:27:09 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/**
+ * @brief Remove the ANSI colour codes of a line, in place
+ * @param line The line
+*/
+static void	bench_strip(char *line)
+{
+	char	*out;
+
+	out = line;
+	while (*line != '\0')
+	{
+		if (*line == '\033')
+		{
+			while (*line != '\0' && *line != 'm')
+				line++;
+			if (*line != '\0')
+				line++;
+		}
+		else
+			*out++ = *line++;
+	}
+	*out = '\0';
+}
+
+/**
+ * @brief Account for the end of a meal or of a nap
+ * @param stats The stats
+ * @param line The message of the line
+ * @param ms When it was printed
+ * @param id The philo, from 0
+ *
+ * @details
+ * A philo falls asleep when his meal is over and thinks when his nap is
+ * over: how much later than asked that is, is how late he woke up.
+*/
+static void	bench_late(t_stats *stats, char *line, long ms, int id)
+{
+	if (strncmp(line, "is sleeping", 11) == 0)
+	{
+		bench_push(&stats->late, ms - stats->last[id] - stats->c->eat);
+		stats->slept[id] = ms;
+	}
+	else if (strncmp(line, "is thinking", 11) == 0 && stats->slept[id] > 0)
+		bench_push(&stats->late, ms - stats->slept[id] - stats->c->sleep);
+}
+
+/**
+ * @brief Account for a line of output: "<ms> <id> <message>"
+ * @param stats The stats
+ * @param line The line, without its newline
+ *
+ * @details
+ * A meal closes the gap since the philo's previous meal (or since the
+ * start), a death closes his last one. Naps are for bench_late.
+*/
+static void	bench_line(t_stats *stats, char *line)
+{
+	long	ms;
+	int		id;
+	int		len;
+
+	bench_strip(line);
+	if (sscanf(line, "%ld %d %n", &ms, &id, &len) != 2
+		|| id < 1 || id > stats->c->philos)
+		return ;
+	line += len;
+	id--;
+	if (strncmp(line, "is eating", 9) == 0)
+	{
+		bench_push(&stats->gaps, ms - stats->last[id]);
+		stats->last[id] = ms;
+		stats->meals[id]++;
+		stats->eaten++;
+	}
+	else if (strncmp(line, "died", 4) == 0)
+	{
+		bench_push(&stats->gaps, ms - stats->last[id]);
+		stats->died = ms;
+	}
+	else
+		bench_late(stats, line, ms, id);
+}
+
+/**
+ * @brief Feed a chunk of output to the stats, line by line
+ * @param stats The stats
+ * @param buf The chunk
+ * @param len Its length
+ *
+ * @details
+ * A chunk can end in the middle of a line, what's left of it waits in
+ * stats->line for the next chunk.
+*/
+void	bench_feed(t_stats *stats, char *buf, ssize_t len)
+{
+	while (len-- > 0)
+	{
+		if (*buf == '\n' || stats->line_len == BENCH_LINE - 1)
+		{
+			stats->line[stats->line_len] = '\0';
+			bench_line(stats, stats->line);
+			stats->line_len = 0;
+		}
+		else
+			stats->line[stats->line_len++] = *buf;
+		buf++;
+	}
+}
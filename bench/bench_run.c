@@ -0,0 +1,165 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_run.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:27:09 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/**
+ * @brief Wall clock time on the monotonic clock
+ *
+ * @return The time in seconds
+*/
+double	bench_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+/**
+ * @brief Exec the binary, with its output going into a pipe
+ * @param bench The benchmark settings
+ * @param c The point of the sweep
+ * @param fds The pipe
+ *
+ * @attention Only returns if exec failed.
+*/
+static void	bench_exec(t_bench *bench, t_case *c, int fds[2])
+{
+	char	*argv[BENCH_EXTRA + 7];
+	int		i;
+
+	setpgid(0, 0);
+	dup2(fds[1], STDOUT_FILENO);
+	close(fds[0]);
+	close(fds[1]);
+	argv[0] = bench->bin;
+	i = -1;
+	while (++i < 5)
+		argv[i + 1] = c->argv[i];
+	i = -1;
+	while (++i < bench->extra_total)
+		argv[i + 6] = bench->extra[i];
+	argv[i + 6] = NULL;
+	execv(bench->bin, argv);
+	perror(bench->bin);
+}
+
+/**
+ * @brief Start the binary in a process group of its own
+ * @param bench The benchmark settings
+ * @param c The point of the sweep
+ * @param out Where to store the read end of its output
+ *
+ * @details
+ * Its own group lets a timed out run be killed together with whatever
+ * it forked (philo_bonus's philos).
+ *
+ * @return Its pid, -1 on error.
+*/
+static pid_t	bench_spawn(t_bench *bench, t_case *c, int *out)
+{
+	int		fds[2];
+	pid_t	pid;
+
+	if (pipe(fds) != 0)
+		return (-1);
+	pid = fork();
+	if (pid == 0)
+	{
+		bench_exec(bench, c, fds);
+		_exit(127);
+	}
+	close(fds[1]);
+	if (pid < 0)
+	{
+		close(fds[0]);
+		return (-1);
+	}
+	setpgid(pid, pid);
+	*out = fds[0];
+	return (pid);
+}
+
+/**
+ * @brief Read the output of a run until it's done, or killed for taking
+ *        too long
+ * @param run The run
+ * @param fd The read end of its output
+ * @param pid Its pid
+ * @param timeout Longest it may take (s)
+*/
+static void	bench_collect(t_run *run, int fd, pid_t pid, double timeout)
+{
+	struct pollfd	pfd;
+	char			buf[BENCH_READ];
+	ssize_t			len;
+	double			start;
+
+	pfd.fd = fd;
+	pfd.events = POLLIN;
+	start = bench_now();
+	len = 1;
+	while (len > 0)
+	{
+		if (run->timed_out == 0 && bench_now() - start > timeout)
+		{
+			kill(-pid, SIGKILL);
+			run->timed_out = 1;
+		}
+		if (poll(&pfd, 1, BENCH_POLL_MS) <= 0)
+			continue ;
+		len = read(fd, buf, sizeof(buf));
+		if (len > 0)
+			bench_feed(&run->stats, buf, len);
+	}
+	close(fd);
+}
+
+/**
+ * @brief Run the binary once and gather its stats
+ * @param bench The benchmark settings
+ * @param run The run, its case filled in
+ *
+ * @details
+ * wait4 gives the CPU time and context switches of the binary, including
+ * the children it waited for, and how it ended.
+ *
+ * @return 1 on success, 0 on error. A run of the binary that failed is
+ *         still a success here, its status says so.
+*/
+int	bench_run(t_bench *bench, t_run *run)
+{
+	int		fd;
+	int		status;
+	pid_t	pid;
+	double	start;
+
+	run->timed_out = 0;
+	if (bench_stats_init(&run->stats, &run->c) == 0)
+		return (0);
+	start = bench_now();
+	pid = bench_spawn(bench, &run->c, &fd);
+	if (pid < 0)
+		return (0);
+	bench_collect(run, fd, pid, bench->timeout);
+	if (wait4(pid, &status, 0, &run->usage) < 0)
+		return (0);
+	kill(-pid, SIGKILL);
+	run->status = 0;
+	if (WIFEXITED(status))
+		run->status = WEXITSTATUS(status);
+	else if (WIFSIGNALED(status))
+		run->status = 128 + WTERMSIG(status);
+	run->wall = bench_now() - start;
+	return (1);
+}
@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_series.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:05:23 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:05:23 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/**
+ * @brief Make room for the first measures of a series
+ * @param series The series
+ *
+ * @return 1 on success, 0 if the allocation failed.
+*/
+int	bench_series_init(t_series *series)
+{
+	series->total = 0;
+	series->cap = 1024;
+	series->v = malloc(sizeof(long) * series->cap);
+	return (series->v != NULL);
+}
+
+/**
+ * @brief Add a measure to a series, growing it if it's full
+ * @param series The series
+ * @param value The measure (ms)
+*/
+void	bench_push(t_series *series, long value)
+{
+	long	*grown;
+
+	if (series->total == series->cap)
+	{
+		grown = realloc(series->v, sizeof(long) * series->cap * 2);
+		if (grown == NULL)
+			return ;
+		series->v = grown;
+		series->cap *= 2;
+	}
+	series->v[series->total++] = value;
+}
+
+/**
+ * @brief qsort comparator for the measures
+*/
+static int	bench_cmp(const void *a, const void *b)
+{
+	long	x;
+	long	y;
+
+	x = *(const long *)a;
+	y = *(const long *)b;
+	return ((x > y) - (x < y));
+}
+
+/**
+ * @brief Sort a series, shall call before bench_percentile
+ * @param series The series
+*/
+void	bench_series_sort(t_series *series)
+{
+	qsort(series->v, series->total, sizeof(long), &bench_cmp);
+}
+
+/**
+ * @brief A percentile of a series (nearest rank)
+ * @param series The series, sorted
+ * @param q The percentile, between 0 and 1
+ *
+ * @return The measure (ms), 0 if there's none.
+*/
+long	bench_percentile(t_series *series, double q)
+{
+	if (series->total == 0)
+		return (0);
+	return (series->v[(int)((series->total - 1) * q + 0.5)]);
+}
@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_stats.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:27:09 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "bench.h"
+
+/**
+ * @brief Get ready to read the output of a run
+ * @param stats The stats
+ * @param c The point of the sweep that is run
+ *
+ * @return 1 on success, 0 if an allocation failed.
+*/
+int	bench_stats_init(t_stats *stats, t_case *c)
+{
+	memset(stats, 0, sizeof(t_stats));
+	stats->c = c;
+	stats->died = -1;
+	stats->meals = calloc(c->philos, sizeof(long));
+	stats->last = calloc(c->philos, sizeof(long));
+	stats->slept = calloc(c->philos, sizeof(long));
+	return (stats->meals != NULL && stats->last != NULL
+		&& stats->slept != NULL && bench_series_init(&stats->gaps)
+		&& bench_series_init(&stats->late));
+}
+
+/**
+ * @brief Sort the series of a run, shall call before bench_percentile
+ * @param stats The stats
+*/
+void	bench_stats_sort(t_stats *stats)
+{
+	bench_series_sort(&stats->gaps);
+	bench_series_sort(&stats->late);
+}
+
+/**
+ * @brief Jain's fairness index of the meals each philo ate
+ * @param stats The stats
+ *
+ * @details
+ * (sum x)^2 / (n * sum x^2): 1 when every philo ate as much, down to 1/n
+ * when a single philo ate everything.
+ *
+ * @return The index, 0 if nobody ate.
+*/
+double	bench_jain(t_stats *stats)
+{
+	int		i;
+	double	sum;
+	double	squares;
+
+	i = -1;
+	sum = 0;
+	squares = 0;
+	while (++i < stats->c->philos)
+	{
+		sum += stats->meals[i];
+		squares += (double)stats->meals[i] * stats->meals[i];
+	}
+	if (squares == 0)
+		return (0);
+	return (sum * sum / (stats->c->philos * squares));
+}
+
+/**
+ * @brief Free the stats
+ * @param stats The stats
+*/
+void	bench_stats_free(t_stats *stats)
+{
+	free(stats->meals);
+	free(stats->last);
+	free(stats->slept);
+	free(stats->gaps.v);
+	free(stats->late.v);
+}
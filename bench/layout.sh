@@ -0,0 +1,39 @@
+#!/bin/sh
+# Compare the cache line padded layout with the packed one (make PACKED=1)
+# on the hardware cache counters.
+#
+# usage: bench/layout.sh [philo args...]
+#
+# The default workload keeps 200 philos eating and sleeping 10ms at a time,
+# so last_ate, the forks and the log rings are written to all the time.
+# RUNS sets how many times perf repeats each binary (default 5).
+
+set -e
+
+EVENTS="cache-references,cache-misses,L1-dcache-load-misses,LLC-load-misses"
+RUNS=${RUNS:-5}
+
+cd "$(dirname "$0")/../philo"
+
+if [ $# -eq 0 ]; then
+	set -- 200 100 10 10 100
+fi
+
+if ! command -v perf >/dev/null 2>&1; then
+	echo "perf not found (linux-tools), can't read the cache counters" >&2
+	exit 1
+fi
+
+OUT=$(mktemp -d)
+
+make -s fclean >/dev/null && make -s PACKED=1 >/dev/null && mv philo "$OUT/philo_packed"
+make -s fclean >/dev/null && make -s >/dev/null && cp philo "$OUT/philo_padded"
+make -s fclean >/dev/null
+
+for layout in packed padded; do
+	echo "== $layout: ./philo $*"
+	perf stat -r "$RUNS" -e "$EVENTS" "$OUT/philo_$layout" "$@" \
+		2>&1 >/dev/null | grep -E "cache|elapsed"
+done
+
+rm -rf "$OUT"
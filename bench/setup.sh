@@ -0,0 +1,25 @@
+#!/bin/sh
+# Time how long it takes to set the table and clear it on very large
+# tables: the per seat arena mapped, filled up and torn down again, with
+# nobody sitting down (--empty).
+#
+# usage: bench/setup.sh [philo options...]
+#
+# SEATS sets the table sizes (default "10000 100000 1000000"), each run
+# once with small pages and once with --hugepages. make bench runs it
+# after the sweep; run on its own, it builds ./philo first if needed.
+
+set -e
+
+SEATS=${SEATS:-"10000 100000 1000000"}
+
+cd "$(dirname "$0")/../philo"
+
+make -s >/dev/null
+
+for seats in $SEATS; do
+	for huge in "" --hugepages; do
+		./philo "$seats" 800 200 200 --empty --report $huge "$@" \
+			2>&1 >/dev/null | grep "setup="
+	done
+done
@@ -6,7 +6,7 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/10 15:15:04 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/02/27 15:51:50 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 23:18:04 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,12 +14,69 @@
 # define PHILO_H
 
 /* ====== LIBRARIES ====== */
+/* CPU affinity (--affinity) is a GNU extension */
+# ifndef _GNU_SOURCE
+#  define _GNU_SOURCE
+# endif
 # include <stdio.h>
 # include <string.h>
 # include <stdlib.h>
 # include <unistd.h>
-# include <sys/time.h>
 # include <pthread.h>
+# include <stdatomic.h>
+# include <limits.h>
+# include <stdint.h>
+# include <time.h>
+# include <sched.h>
+# include <ucontext.h>
+# include <sys/mman.h>
+# include <errno.h>
+# include <fcntl.h>
+# include <linux/futex.h>
+# include <sys/syscall.h>
+
+/* ====== BUILD OPTIONS ====== */
+
+/**
+ * PL_ATOMIC (make ATOMIC=1): last_ate and meal_count are published with
+ * C11 atomics (release / acquire) instead of being guarded by mutexes.
+*/
+# ifndef PL_ATOMIC
+#  define PL_ATOMIC 0
+# endif
+
+# if PL_ATOMIC
+#  define PL_HOT _Atomic
+# else
+#  define PL_HOT
+# endif
+
+/**
+ * PL_LOCKSTAT (make LOCKSTAT=1): every mutex is a t_stat_mutex, counting
+ * its acquisitions, contended ones, wait and hold times. A ranked report
+ * goes to stderr as they're torn down. Bigger locks, and a clock read or
+ * two per lock: only there to find where the time goes.
+*/
+# ifndef PL_LOCKSTAT
+#  define PL_LOCKSTAT 0
+# endif
+
+/**
+ * PL_PACKED (make PACKED=1): forks, philos and log rings are packed back
+ * to back instead of starting on their own cache line. Only there to
+ * measure what the padding buys (see bench/layout.sh).
+*/
+# ifndef PL_PACKED
+#  define PL_PACKED 0
+# endif
+
+# define PL_CACHE_LINE 64
+
+# if PL_PACKED
+#  define PL_LINE
+# else
+#  define PL_LINE __attribute__((aligned(PL_CACHE_LINE)))
+# endif
 
 /* ====== TEXT STYLING ====== */
 # define RED "\033[1;31m"
@@ -31,6 +88,85 @@
 # define WHT "\033[1;37m"
 # define DEF "\033[0m"
 
+/* ====== MACROS ====== */
+
+/**
+ * LOG_RING_SIZE	Events each philo can have in flight (power of two)
+ * LOG_BUF_SIZE		Size of the log writer's output buffer
+ * LOG_FLUSH_US		How often (us) the log writer drains the rings
+ * LOG_IDLE			Pending time of a ring that is not logging anything, what
+ * 					a ring fresh from the arena reads
+ * LOG_BIN_RECORD	Size of an event in the binary format (--format=bin)
+*/
+# define LOG_RING_SIZE 256
+# define LOG_BUF_SIZE 65536
+# define LOG_FLUSH_US 1000
+# define LOG_IDLE 0
+# define LOG_BIN_RECORD 13
+
+/**
+ * RT_PRIO		Priority of philo threads with --rt=<policy> and no :<prio>
+ * RT_NODE_MAX	Most NUMA nodes looked up by --affinity=numa
+ * RT_MLOCK		What --mlock locks: every page, now and to come, once it's
+ * 				touched (thread stacks aren't filled up front)
+*/
+# define RT_PRIO 10
+# define RT_NODE_MAX 64
+# define RT_MLOCK (MCL_CURRENT | MCL_FUTURE | MCL_ONFAULT)
+
+/**
+ * TICK_US	Ticks (ns) in one microsecond
+ * TICK_MS	Ticks (ns) in one millisecond
+ * TICK_S	Ticks (ns) in one second
+*/
+# define TICK_US 1000LL
+# define TICK_MS 1000000LL
+# define TICK_S 1000000000LL
+
+/**
+ * BACKOFF_MIN	First back off (ticks) after a failed trylock, doubles on
+ * 				every failure after it
+ * BACKOFF_MAX	Longest back off (ticks)
+*/
+# define BACKOFF_MIN 20000LL
+# define BACKOFF_MAX 1000000LL
+
+/**
+ * CORO_STACK	Stack size of a philo coroutine (--engine=coro)
+ * CORO_IDLE	Longest (ticks) an idle worker naps before looking for
+ * 				work to steal again
+*/
+# define CORO_STACK 32768
+# define CORO_IDLE 1000000LL
+
+/**
+ * ARENA_HUGE		Huge page size, the arena is rounded up to a whole number
+ * 					of them with --hugepages
+ * ARENA_CHUNK		Fewest seats worth a thread of their own at set up
+ * ARENA_FILL_MAX	Most threads setting up the arena at once
+*/
+# define ARENA_HUGE 2097152
+# define ARENA_CHUNK 4096
+# define ARENA_FILL_MAX 64
+
+/**
+ * TRACE_CHUNK	Marks a trace starts with room for, it doubles when full
+*/
+# define TRACE_CHUNK 1024
+
+/**
+ * LOCKSTAT_TOP	Worst locks listed one by one in the contention report
+*/
+# define LOCKSTAT_TOP 10
+
+/* ====== TYPES ====== */
+
+/**
+ * @brief A point in time: nanoseconds on the monotonic clock.
+ *        Converted to milliseconds only when printed.
+*/
+typedef int64_t	t_tick;
+
 /* ====== ENUMS ====== */
 
 /**
@@ -72,6 +208,29 @@ typedef enum e_fork_action
 	RETURN
 }		t_fork_action;
 
+/**
+ * @brief Enum for what a mutex guards, for the contention report
+ *        (LOCKSTAT=1)
+ * 
+ * @param LOCK_FORK			A fork
+ * @param LOCK_LAST_ATE		A philo's last_ate
+ * @param LOCK_MEAL_COUNT	A philo's meal_count
+ * @param LOCK_FULL			The full counter
+ * @param LOCK_WAITER		The waiter ("waiter")
+ * @param LOCK_RUNQ			A worker's run queue (--engine=coro)
+ * @param LOCK_CLASSES		Number of classes
+*/
+typedef enum e_lock_class
+{
+	LOCK_FORK,
+	LOCK_LAST_ATE,
+	LOCK_MEAL_COUNT,
+	LOCK_FULL,
+	LOCK_WAITER,
+	LOCK_RUNQ,
+	LOCK_CLASSES
+}		t_lock_class;
+
 /**
  * @brief Enum for lock type
  * 
@@ -84,6 +243,105 @@ typedef enum e_lock_type
 	PHILO
 }		t_lock_type;
 
+/**
+ * @brief Enum for the output formats (--format)
+ * 
+ * @param TEXT	"%8ld %3d <message>" with colours, for humans (default)
+ * @param PLAIN	"<ms> <id> <message>", no colours
+ * @param CSV	"<us>,<id>,<state>" after a header line
+ * @param BIN	Fixed size records, see pl_format_event
+*/
+typedef enum e_format
+{
+	TEXT,
+	PLAIN,
+	CSV,
+	BIN
+}		t_format;
+
+/**
+ * @brief Enum for the simulation engines (--engine)
+ * 
+ * @param THREADS	A thread per philo, on the wall clock (default)
+ * @param DES		Discrete events on a single thread, in virtual time
+ * @param CORO		A coroutine per philo, on a pool of worker threads
+*/
+typedef enum e_engine
+{
+	THREADS,
+	DES,
+	CORO
+}		t_engine;
+
+/**
+ * @brief Enum for when philos reach for their forks (--sched)
+ * 
+ * @param STAGGER	Odd philos start late by half a meal, then everyone
+ * 					reaches for the forks as soon as he's done thinking
+ * 					(default)
+ * @param ADAPTIVE	Every philo has a slot in a cyclic schedule, see
+ * 					t_schedule
+*/
+typedef enum e_sched
+{
+	STAGGER,
+	ADAPTIVE
+}		t_sched;
+
+/**
+ * @brief Enum for why a coroutine handed control back to its worker
+ * 
+ * @param PARK_SLEEP	Sleeping until its wake up time
+ * @param PARK_FORK		Waiting for a fork to be handed over
+ * @param PARK_DONE		Done for good
+*/
+typedef enum e_park
+{
+	PARK_SLEEP,
+	PARK_FORK,
+	PARK_DONE
+}		t_park;
+
+/**
+ * @brief Enum for what a trace mark starts (--trace). A span lasts until
+ *        the next mark of the same trace, the instants don't last.
+ * 
+ * @param SPAN_THINK	Thinking, or waiting for a slot (philo)
+ * @param SPAN_WAIT		Waiting for the forks (philo)
+ * @param SPAN_EAT		Eating (philo)
+ * @param SPAN_SLEEP	Sleeping (philo)
+ * @param SPAN_FORK		Took a fork, an instant (philo)
+ * @param SPAN_CHECK	Checking the deadlines (monitor)
+ * @param SPAN_NAP		Sleeping until the next deadline (monitor)
+ * @param SPAN_DIED		Found a philo dead, an instant (monitor)
+*/
+typedef enum e_span
+{
+	SPAN_THINK,
+	SPAN_WAIT,
+	SPAN_EAT,
+	SPAN_SLEEP,
+	SPAN_FORK,
+	SPAN_CHECK,
+	SPAN_NAP,
+	SPAN_DIED
+}		t_span;
+
+/**
+ * @brief Enum for how threads are pinned to CPUs (--affinity)
+ * 
+ * @param PIN_NONE	Left to the scheduler (default)
+ * @param PIN_RR	Round-robin over the allowed CPUs
+ * @param PIN_NUMA	Neighbours on the same NUMA node, CPUs handed out node
+ * 					by node in contiguous blocks
+*/
+typedef enum e_pin
+{
+	PIN_NONE,
+	PIN_RR,
+	PIN_NUMA
+}		t_pin;
+
 /**
  * @brief Enum for errors
  * 
@@ -91,9 +349,14 @@ typedef enum e_lock_type
  * @param NON_NUMERIC_ARGS		Consists of non numeric arguments
  * @param NEGATIVE_ARGS			Consists of non positive numeric arguments
  * @param INVALID_OPTION		Optional option not more than 0
+ * @param INVALID_FLAG			Unknown or malformed --name=value option
+ * @param ENGINE_FLAG			Option the engine doesn't run (--engine=des or
+ * 								coro)
  * @param CREATE_THD_FAILED		Failed to create thread
  * @param CREATE_MUT_FAILED		Failed to create mutex
  * @param DESTROY_MUT_FAILED	Failed to destroy mutex
+ * @param ARENA_FAILED			Failed to map the arena
+ * @param ENGINE_FAILED			Failed to allocate the engine (des or coro)
 */
 typedef enum e_error
 {
@@ -101,126 +364,798 @@ typedef enum e_error
 	NON_NUMERIC_ARGS,
 	NEGATIVE_ARGS,
 	INVALID_OPTION,
+	INVALID_FLAG,
+	ENGINE_FLAG,
 	CREATE_THD_FAILED,
 	CREATE_MUT_FAILED,
 	DESTROY_MUT_FAILED,
+	ARENA_FAILED,
+	ENGINE_FAILED,
 	ERROR_TOTAL
 }		t_error;
 
 /* ====== STRUCTS ====== */
 
+/**
+ * @brief What a mutex went through (LOCKSTAT=1)
+ * 
+ * @param acquired		Times it was locked
+ * @param contended		Times it was already locked, and had to be waited for
+ * @param wait_total	Time spent waiting for it
+ * @param wait_max		Longest wait
+ * @param hold_total	Time it was held
+ * @param hold_max		Longest hold
+*/
+typedef struct s_lock_stats
+{
+	long	acquired;
+	long	contended;
+	t_tick	wait_total;
+	t_tick	wait_max;
+	t_tick	hold_total;
+	t_tick	hold_max;
+}		t_lock_stats;
+
+/**
+ * @brief A mutex keeping its own stats (LOCKSTAT=1). They're only
+ *        written by whoever holds it.
+ * 
+ * @param mutex	The mutex
+ * @param since	When its holder locked it
+ * @param stats	Its stats
+*/
+typedef struct s_stat_mutex
+{
+	pthread_mutex_t	mutex;
+	t_tick			since;
+	t_lock_stats	stats;
+}		t_stat_mutex;
+
+/**
+ * t_mutex		Every mutex of the simulation, only ever used through the
+ * 				pl_mutex_* functions
+ * PL_MUTEX_INIT	Its static initialiser
+*/
+# if PL_LOCKSTAT
+typedef t_stat_mutex	t_mutex;
+#  define PL_MUTEX_INIT {PTHREAD_MUTEX_INITIALIZER, 0, {0, 0, 0, 0, 0, 0}}
+# else
+typedef pthread_mutex_t	t_mutex;
+#  define PL_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+# endif
+
+/**
+ * @brief One of the worst locks (LOCKSTAT=1)
+ * 
+ * @param cls	What it guarded
+ * @param id	Which one of them (a philo or fork index, a worker)
+ * @param stats	Its stats
+*/
+typedef struct s_lock_rank
+{
+	t_lock_class	cls;
+	int				id;
+	t_lock_stats	stats;
+}		t_lock_rank;
+
+/**
+ * @brief Stats of every mutex, gathered as they're torn down (LOCKSTAT=1)
+ * 
+ * @param classes	Stats added up per class (the max as a max)
+ * @param locks		Number of mutexes per class
+ * @param top		The worst locks by time waited, worst first
+ * @param ranked	Number of locks in top
+*/
+typedef struct s_lockstat
+{
+	t_lock_stats	classes[LOCK_CLASSES];
+	long			locks[LOCK_CLASSES];
+	t_lock_rank		top[LOCKSTAT_TOP];
+	int				ranked;
+}		t_lockstat;
+
 /**
  * @brief A struct that store all the additional mutexes (shared)
  * 
- * @param declare_lock		Philo's declare mutex
- * @param sim_state_lock	Philo's simulation state mutex
+ * @param full_lock			Philo full counter mutex
 */
 typedef struct s_locks
 {
-	pthread_mutex_t	declare_lock;
-	pthread_mutex_t	sim_state_lock;
-	pthread_mutex_t	death_lock;
-	pthread_mutex_t	full_lock;
+	t_mutex	full_lock;
 }		t_locks;
 
+/**
+ * @brief A state change of a philo, waiting to be printed
+ * 
+ * @param time	 When it happened
+ * @param id	 The philo ID (starts from 0)
+ * @param state	 The new state of the philo
+*/
+typedef struct s_event
+{
+	t_tick	time;
+	int		id;
+	t_state	state;
+}		t_event;
+
+/**
+ * @brief Single producer, single consumer ring of events
+ * 
+ * @param head		Next event to be read (log writer only)
+ * @param tail		Next free slot (owner philo only)
+ * @param pending	Time the owner started logging an event, or LOG_IDLE
+ * @param events	The events
+ * 
+ * @attention head and tail are written by different threads, so they
+ *            don't share a cache line.
+*/
+typedef struct s_ring
+{
+	PL_LINE atomic_size_t	head;
+	PL_LINE atomic_size_t	tail;
+	_Atomic t_tick			pending;
+	t_event					events[LOG_RING_SIZE];
+}		t_ring;
+
+/**
+ * @brief The logger. Philos push their events into their own ring, one
+ *        writer thread merges the rings by time and prints them.
+ * 
+ * @param rings			One ring per philo
+ * @param ring_total	Number of rings
+ * @param stage			Events drained from the rings, waiting to be printed
+ * @param staged		Number of staged events
+ * @param buf			Output buffer of the writer
+ * @param len			Number of bytes in buf
+ * @param start_time	The start time of the simulation
+ * @param halt			The event that ends the log (DIED or FULL)
+ * @param halted		0: running, 1: halt being recorded, 2: halt recorded
+ * @param stop			Set to stop the writer
+ * @param done			The halt event has been printed, print nothing else
+ * @param writer		The writer thread
+ * @param format		How events are printed
+*/
+typedef struct s_log
+{
+	t_ring			*rings;
+	int				ring_total;
+	t_event			*stage;
+	int				staged;
+	char			*buf;
+	int				len;
+	t_tick			start_time;
+	t_event			halt;
+	atomic_int		halted;
+	atomic_int		stop;
+	int				done;
+	pthread_t		writer;
+	t_format		format;
+}		t_log;
+
+struct	s_philo;
+struct	s_simulation;
+
+/**
+ * @brief A way of taking the forks (see pl_fork_strategy)
+ * 
+ * @param name		Name given to --fork
+ * @param stagger	Odd philos wait before their first meal, the strategy
+ * 					relies on it to not deadlock or starve a philo
+ * @param init		Set up the strategy's shared state, can be NULL
+ * @param take		Take both forks, declaring them. Returns 0 if it gave
+ * 					up as the simulation ended, holding neither
+ * @param put		Put both forks back
+ * @param destroy	Tear the shared state down, can be NULL
+*/
+typedef struct s_fork_strategy
+{
+	char	*name;
+	int		stagger;
+	int		(*init)(struct s_simulation *sim);
+	int		(*take)(struct s_philo *philo);
+	void	(*put)(struct s_philo *philo);
+	void	(*destroy)(struct s_simulation *sim);
+}		t_fork_strategy;
+
+/**
+ * @brief The waiter of the "waiter" fork strategy
+ * 
+ * @param lock	Protects the forks' in_use, claim and claim_since
+ * @param cond	Signalled when forks are given back
+*/
+typedef struct s_waiter
+{
+	t_mutex			lock;
+	pthread_cond_t	cond;
+}		t_waiter;
+
+/**
+ * @brief Optional settings, given as `--name=value` after the arguments
+ * 
+ * @param spin		How long before a wake up a philo stops sleeping and
+ * 					yields the CPU until the deadline instead (ticks)
+ * @param fork		How philos take their forks
+ * @param report	Print meals/s and the worst fork wait to stderr at
+ * 					the end (--report)
+ * @param format	How events are printed
+ * @param engine	What runs the simulation
+ * @param sched		When philos reach for their forks
+ * @param pin		How threads are pinned to CPUs
+ * @param rt_policy	SCHED_FIFO or SCHED_RR (--rt), SCHED_OTHER if off
+ * @param rt_prio	Real-time priority of the philos, the monitor gets one
+ * 					more
+ * @param mlock		Lock every page in memory (--mlock)
+ * @param huge		Back the arena with huge pages (--hugepages)
+ * @param empty		Set the table and clear it, nobody sits down (--empty)
+ * @param trace		Where to write the timelines at the end (--trace),
+ * 					NULL if off
+*/
+typedef struct s_options
+{
+	t_tick					spin;
+	const t_fork_strategy	*fork;
+	int						report;
+	t_format				format;
+	t_engine				engine;
+	t_sched					sched;
+	t_pin					pin;
+	int						rt_policy;
+	int						rt_prio;
+	int						mlock;
+	int						huge;
+	int						empty;
+	char					*trace;
+}		t_options;
+
+/**
+ * @brief The CPUs threads get pinned to (--affinity)
+ * 
+ * @param order	The allowed CPUs, in the order they're handed out
+ * @param total	Number of CPUs, 0 if threads aren't pinned
+*/
+typedef struct s_cpus
+{
+	int	*order;
+	int	total;
+}		t_cpus;
+
+/**
+ * @brief The cyclic schedule of --sched=adaptive
+ * 
+ * @param at_once	How many philos eat at the same time, philo_total / 2
+ * @param unit		A meal is at_once units long (ticks)
+ * @param period	Time between two meals of a philo (ticks)
+ * @param survivable	The period is shorter than time_to_die
+ * 
+ * @details
+ * Philo i's slots start (i * at_once % philo_total) units after the
+ * start, then every period. Two neighbours' slots are at_once units
+ * apart, so their meals never overlap, and at_once philos eat at any
+ * time. No schedule can do better: at most at_once philos eat at once,
+ * and a philo has to eat and sleep between two meals.
+*/
+typedef struct s_schedule
+{
+	int		at_once;
+	t_tick	unit;
+	t_tick	period;
+	int		survivable;
+}		t_schedule;
+
 /**
  * @brief Struct for the simulation rules
  * 
- * @param sim_state 	The state of the simulation
+ * @param sim_state 	The state of the simulation, RUN or END: read
+ * 						without a lock, and a futex to sleep on
  * @param start_time	The start time of the simulation
+ * @param start_line	0 until the start, the spawned threads sleep on it
+ * 						(a futex)
  * @param philo_total 	Number of philos
  * @param time_to_die 	Time to die in ms
  * @param time_to_eat 	Time to eat in ms
  * @param time_to_sleep Time to sleep in ms
  * @param iteration 	Number of simulation
+ * @param log 			The logger
+ * @param waiter 		The waiter of the "waiter" fork strategy
+ * @param sched 		The schedule (--sched=adaptive)
+ * @param cpus 			The CPUs threads get pinned to (--affinity)
+ * @param opts 			Optional settings
 */
 typedef struct s_rules
 {
-	t_state	sim_state;
-	time_t	start_time;
-	int		philo_total;
-	int		time_to_die;
-	int		time_to_eat;
-	int		time_to_sleep;
-	int		iteration;
-	int		philo_full;
-	t_locks	locks;
+	atomic_int	sim_state;
+	t_tick		start_time;
+	atomic_int	start_line;
+	int			philo_total;
+	int			time_to_die;
+	int			time_to_eat;
+	int			time_to_sleep;
+	int			iteration;
+	int			philo_full;
+	t_locks		locks;
+	t_log		log;
+	t_waiter	waiter;
+	t_schedule	sched;
+	t_cpus		cpus;
+	t_options	opts;
 }		t_rules;
 
+/**
+ * @brief A fork, on a cache line of its own (unless PL_PACKED)
+ * 
+ * @param lock		The fork itself, or what protects the fields below
+ * 					under the "chandy" strategy
+ * @param cond		Signalled when the fork gets dirty or is put down
+ * @param owner		Philo holding the fork ("chandy")
+ * @param dirty		Has been eaten with since it changed hands ("chandy")
+ * @param in_use	Its owner is eating with it ("chandy", "waiter")
+ * @param ticket	Next ticket to hand out ("fifo")
+ * @param serving	Ticket now holding the fork ("fifo")
+ * @param queued	Philos queued for the fork, holder included ("fifo")
+ * @param queue_max	Longest the queue got ("fifo")
+ * @param wait_total	Time spent queued for the fork, all philos ("fifo")
+ * @param waiter	Coroutine waiting for the fork (--engine=coro)
+ * @param claim		Hungriest philo waiting for the fork, NULL if none
+ * 					("waiter")
+ * @param claim_since	When he last ate ("waiter")
+*/
+typedef struct s_fork
+{
+	PL_LINE t_mutex			lock;
+	pthread_cond_t			cond;
+	int						owner;
+	int						dirty;
+	int						in_use;
+	unsigned long			ticket;
+	unsigned long			serving;
+	int						queued;
+	int						queue_max;
+	t_tick					wait_total;
+	struct s_coro			*waiter;
+	struct s_philo			*claim;
+	t_tick					claim_since;
+}		t_fork;
+
+/**
+ * @brief A point on a timeline (--trace)
+ * 
+ * @param time	When it happened
+ * @param span	What starts there
+ * @param arg	The philo it's about (SPAN_DIED), -1 if none
+*/
+typedef struct s_mark
+{
+	t_tick	time;
+	t_span	span;
+	int		arg;
+}		t_mark;
+
+/**
+ * @brief The timeline of a single thread (or philo coroutine), only ever
+ *        written by it, read once it's been joined
+ * 
+ * @param marks	The marks, in time order
+ * @param total	Number of marks
+ * @param cap	Room for marks, -1 once a realloc failed (the rest of the
+ * 				timeline is dropped)
+*/
+typedef struct s_trace
+{
+	t_mark	*marks;
+	int		total;
+	int		cap;
+}		t_trace;
+
 /**
  * @brief Struct for each philo
  * 
- * @param id 				Philo ID
+ * @param last_ate 			Philo's last ate time
+ * @param last_ate_lock		Protects last_ate
  * @param meal_count 		Number of meal eaten
+ * @param meal_count_lock	Protects meal_count
+ * @param id 				Philo ID
  * @param full 				Philo's stomach lmao
- * @param last_ate 			Philo's last ate time
+ * @param wait_max			Longest it took to take the forks
+ * @param slot				Start of his next slot (--sched=adaptive), 0
+ * 							until his first one
  * @param me 				The thread
- * @param left_fork 		Left fork (mutex), own index's fork
- * @param right_fork		Right fork (mutex) own index - 1's fork
- * @param locks				The additional locks that prevent data race
+ * @param left_fork 		Left fork, own index's fork
+ * @param right_fork		Right fork, own index - 1's fork
  * @param rules 			The simulation rules
+ * @param trace				His timeline (--trace)
  * 
  * @attention These info should be private for each philo only
+ * 
+ * @details
+ * last_ate is the only field the monitor touches (and its lock, which the
+ * monitor writes to when locking it). It gets a cache line of its own, so
+ * neither the monitor nor the neighbouring philos keep stealing the line
+ * holding the rest, which only the owner thread uses.
 */
 typedef struct s_philo
 {
+	PL_LINE PL_HOT t_tick	last_ate;
+	t_mutex					last_ate_lock;
+	PL_LINE PL_HOT int		meal_count;
+	t_mutex					meal_count_lock;
+	int						id;
+	int						full;
+	t_tick					wait_max;
+	t_tick					slot;
+	pthread_t				me;
+	t_fork					*left_fork;
+	t_fork					*right_fork;
+	t_rules					*rules;
+	t_trace					trace;
+}		t_philo;
+
+/**
+ * @brief A node of a heap: the monitor's deadlines, or the discrete
+ *        event engine's deadlines and events
+ * 
+ * @param key	The deadline of the philo, a lower bound of the real one,
+ * 				or the time of his next event
+ * @param val	The index of the philo
+*/
+typedef struct s_heap_node
+{
+	t_tick	key;
+	int		val;
+}		t_heap_node;
+
+/**
+ * @brief Binary min-heap ordered by key (a deadline, or when an event is due)
+ * 
+ * @param nodes	The nodes, root at index 0
+ * @param size	Number of nodes in the heap
+*/
+typedef struct s_heap
+{
+	t_heap_node	*nodes;
+	int			size;
+}		t_heap;
+
+/**
+ * @brief A philo running as a coroutine (--engine=coro)
+ * 
+ * @param ctx		Where the philo left off
+ * @param philo		The philo
+ * @param worker	The worker running it (or that last did)
+ * @param park		Why it handed control back
+ * @param wake		When to wake it up (PARK_SLEEP)
+ * @param fork		The fork it waits for (PARK_FORK)
+*/
+typedef struct s_coro
+{
+	ucontext_t		ctx;
+	t_philo			*philo;
+	struct s_worker	*worker;
+	t_park			park;
+	t_tick			wake;
+	t_fork			*fork;
+}		t_coro;
+
+/**
+ * @brief Run queue of a worker, a ring of coroutine indexes. The owner
+ *        takes from the head, idle workers steal from the tail.
+ * 
+ * @param lock	Protects the queue
+ * @param slots	The indexes, room for every coroutine
+ * @param head	Index of the first slot in use
+ * @param size	Number of slots in use
+ * @param cap	Number of slots
+*/
+typedef struct s_runq
+{
+	t_mutex			lock;
+	int				*slots;
+	int				head;
+	int				size;
+	int				cap;
+}		t_runq;
+
+/**
+ * @brief A worker thread of the coroutine engine, on a cache line of its
+ *        own (unless PL_PACKED)
+ * 
+ * @param runq		Coroutines ready to run
+ * @param timers	Sleeping coroutines parked here, ordered by wake up time
+ * @param ctx		The scheduler, where coroutines hand control back to
+ * @param id		Index of the worker
+ * @param me		The thread
+ * @param pool		The pool
+*/
+typedef struct s_worker
+{
+	PL_LINE t_runq	runq;
+	t_heap			timers;
+	ucontext_t		ctx;
 	int				id;
-	int				meal_count;
-	int				full;
-	time_t			last_ate;
 	pthread_t		me;
-	pthread_mutex_t	*left_fork;
-	pthread_mutex_t	*right_fork;
-	pthread_mutex_t	last_ate_lock;
-	pthread_mutex_t	meal_count_lock;
-	t_rules			*rules;
-}		t_philo;
+	struct s_pool	*pool;
+}		t_worker;
+
+/**
+ * @brief The coroutine engine (--engine=coro)
+ * 
+ * @param workers		The workers, one per core (at most one per philo)
+ * @param worker_total	Number of workers
+ * @param coros			One coroutine per philo
+ * @param stacks		The stacks of the coroutines, back to back
+ * @param sim			The simulation
+*/
+typedef struct s_pool
+{
+	t_worker				*workers;
+	int						worker_total;
+	t_coro					*coros;
+	char					*stacks;
+	struct s_simulation		*sim;
+}		t_pool;
+
+/**
+ * @brief A single mapping holding everything there is one of per seat:
+ *        forks, philos, log rings, the monitor's deadlines and the
+ *        coroutines (--engine=coro)
+ * 
+ * @param base		The mapping, NULL if there's none
+ * @param size		Its size
+ * @param used		How much of it is handed out
+ * @param setup		Time it took to map it and set every seat up
+ * @param teardown	Time it took to tear every seat down and unmap it
+*/
+typedef struct s_arena
+{
+	char	*base;
+	size_t	size;
+	size_t	used;
+	t_tick	setup;
+	t_tick	teardown;
+}		t_arena;
 
 /**
  * @brief Struct for simulation
  * 
- * @param philo_full 	The number of philo that are full
  * @param forks 		The fork mutexes
+ * @param philos 		The philos
  * @param rules 		The rules of the simulation
- * 
- * @attention The `n` here refers to the number of iteration
+ * @param monitor 		The death monitor thread (one for the whole table)
+ * @param watched 		The monitor is running
+ * @param spawned 		Philo threads (or workers) running
+ * @param logged 		The logger is running
+ * @param deadlines 	Philos ordered by the time they could starve
+ * @param pool 			The coroutine engine (--engine=coro)
+ * @param arena 		Where the forks, philos and the rest live
+ * @param watch 		The monitor's timeline (--trace)
+ * @param lockstat		Stats of the mutexes torn down so far (LOCKSTAT=1)
 */
 typedef struct s_simulation
 {
-	pthread_mutex_t	*forks;
+	t_fork			*forks;
 	t_philo			*philos;
 	t_rules			*rules;
+	pthread_t		monitor;
+	int				watched;
+	int				spawned;
+	int				logged;
+	t_heap			deadlines;
+	t_pool			pool;
+	t_arena			arena;
+	t_trace			watch;
+	t_lockstat		lockstat;
 }		t_simulation;
 
+/**
+ * @brief A share of the seats, set up by one thread
+ * 
+ * @param sim	The simulation struct, NULL if the main thread set the
+ * 				share up itself
+ * @param lo	First seat
+ * @param hi	Last seat, excluded
+ * @param me	The thread, if it got one
+*/
+typedef struct s_fill
+{
+	t_simulation	*sim;
+	int				lo;
+	int				hi;
+	pthread_t		me;
+}		t_fill;
+
+/**
+ * @brief A philo of the discrete event engine
+ * 
+ * @param state		EAT or SLEEP until his next event, THINK while he's
+ * 					waiting for a fork
+ * @param last_ate	When his last meal started
+ * @param meals		Number of meal eaten
+ * @param forks		Number of fork in hand
+*/
+typedef struct s_des_philo
+{
+	t_state	state;
+	t_tick	last_ate;
+	int		meals;
+	int		forks;
+}		t_des_philo;
+
+/**
+ * @brief A fork of the discrete event engine
+ * 
+ * @param holder	The philo holding it, -1 if it's on the table
+ * @param waiter	The philo waiting for it, -1 if none. Only the other
+ * 					neighbour can be waiting, so there's no queue.
+*/
+typedef struct s_des_fork
+{
+	int	holder;
+	int	waiter;
+}		t_des_fork;
+
+/**
+ * @brief The discrete event engine (--engine=des)
+ * 
+ * @param rules		The simulation rules
+ * @param philos	The philos
+ * @param forks		The forks
+ * @param events	Philos ordered by their next event (end of a meal,
+ * 					of a nap or of the stagger). A philo waiting for a
+ * 					fork has none.
+ * @param deadlines	Philos ordered by the time they could starve, lower
+ * 					bounds like the monitor's
+ * @param now		The virtual time, starts at 0
+ * @param full		Number of philo that are full
+ * @param buf		Output buffer
+ * @param len		Number of bytes in buf
+*/
+typedef struct s_des
+{
+	t_rules		*rules;
+	t_des_philo	*philos;
+	t_des_fork	*forks;
+	t_heap		events;
+	t_heap		deadlines;
+	t_tick		now;
+	int			full;
+	char		*buf;
+	int			len;
+}		t_des;
+
 /* ====== FUNCTION PROTOTYPES ====== */
 
 // Parse
 int		pl_parse(int ac, char **av, t_rules *rules);
+int		pl_parse_options(int ac, char **av, t_options *opts);
+int		pl_parse_choice(char *arg, t_options *opts);
+int		pl_parse_rt(char *arg, t_options *opts);
+char	*pl_opt_value(char *arg, char *name);
 
 // Philos
 void	pl_begin_simulation(t_rules *rules);
+void	pl_philo_init(t_simulation *sim, t_philo *philo, int id);
+void	pl_fork_init(t_simulation *sim, int id);
 int		pl_lock_setup(t_locks *locks, t_philo *philo, t_lock_type type);
 
+// Arena
+int		pl_arena_init(t_simulation *sim);
+void	pl_arena_fill(t_simulation *sim);
+void	pl_arena_free(t_simulation *sim);
+
 // Philos action
 void	*pl_routine(void *arg);
-void	pl_fork_action(t_philo *philo, t_fork_action act);
+int		pl_fork_action(t_philo *philo, t_fork_action act);
+
+// Fork strategies
+const t_fork_strategy	*pl_fork_strategy(char *name);
+void	pl_put_forks(t_philo *philo);
+int		pl_take_naive(t_philo *philo);
+int		pl_take_ordered(t_philo *philo);
+int		pl_take_trylock(t_philo *philo);
+int		pl_waiter_init(t_simulation *sim);
+void	pl_waiter_destroy(t_simulation *sim);
+int		pl_take_waiter(t_philo *philo);
+void	pl_put_waiter(t_philo *philo);
+int		pl_take_chandy(t_philo *philo);
+void	pl_put_chandy(t_philo *philo);
+int		pl_take_fifo(t_philo *philo);
+void	pl_put_fifo(t_philo *philo);
+
+// Coroutine engine
+int		pl_pool_spawn(t_simulation *sim);
+void	pl_pool_join(t_pool *pool);
+void	*pl_worker(void *arg);
+void	pl_coro_main(unsigned int hi, unsigned int lo);
+int		pl_runq_init(t_runq *runq, int cap);
+void	pl_runq_push(t_runq *runq, int index);
+int		pl_runq_pop(t_runq *runq, int steal);
+
+// Start line
+void	pl_start_wait(t_rules *rules);
+int		pl_start_release(t_simulation *sim);
+
+// Real-time (--affinity, --rt, --mlock)
+int		pl_rt_init(t_rules *rules);
+void	pl_rt_warn(char *what, int err);
+void	pl_rt_pin(t_rules *rules, pthread_t thread, int slot, int slots);
+void	pl_rt_boost(t_rules *rules, pthread_t thread);
+int		pl_rt_cpus(t_rules *rules);
+
+// Schedule
+void	pl_sched_init(t_rules *rules);
+t_tick	pl_sched_next(t_philo *philo);
+
+// Report
+void	pl_report(t_simulation *sim);
+void	pl_report_arena(t_simulation *sim);
+
+// Mutexes (stats with LOCKSTAT=1)
+void	pl_mutex_init(t_mutex *mutex);
+void	pl_mutex_lock(t_mutex *mutex);
+int		pl_mutex_trylock(t_mutex *mutex);
+void	pl_mutex_unlock(t_mutex *mutex);
+void	pl_cond_wait(pthread_cond_t *cond, t_mutex *mutex);
+void	pl_mutex_destroy(t_mutex *mutex, t_lockstat *lockstat,
+			t_lock_class cls, int id);
+void	pl_lockstat_add(t_lockstat *lockstat, t_lock_class cls, int id,
+			t_lock_stats *stats);
+void	pl_lockstat_report(t_lockstat *lockstat);
+
+// Trace (--trace)
+void	pl_trace_mark(t_rules *rules, t_trace *trace, t_span span, int arg);
+void	pl_trace_write(t_simulation *sim);
 
 // Monitor
 void	*pl_monitor(void *arg);
+int		pl_spawn_monitor(t_simulation *sim);
+int		pl_full_tracker(t_philo *philo);
+
+// Heap
+int		pl_heap_init(t_heap *heap, int capacity);
+void	pl_heap_push(t_heap *heap, t_tick key, int val);
+void	pl_heap_update_root(t_heap *heap, t_tick key);
+void	pl_heap_pop(t_heap *heap);
+
+// Discrete event engine
+void	pl_des_run(t_rules *rules);
+void	pl_des_log(t_des *des, int id, t_state state);
+void	pl_des_step(t_des *des, int id);
+int		pl_des_take(t_des *des, int id);
 
 // Monitor utils
-time_t	pl_get_last_ate(t_philo *philo);
 t_state	pl_get_sim_state(t_philo *philo);
+void	pl_end_simulation_state(t_rules *rules);
+
+// Philo state (mutex or atomic, see PL_ATOMIC)
+t_tick	pl_get_last_ate(t_philo *philo);
+void	pl_set_last_ate(t_philo *philo, t_tick time);
 int		pl_get_meal_count(t_philo *philo);
+void	pl_add_meal(t_philo *philo);
 
 // Message
 int		pl_show_error(t_error error, int id);
 void	pl_declare_state(t_philo *philo, t_state state);
+int		pl_format_event(char *buf, t_event *event, t_tick start,
+			t_format format);
+int		pl_format_header(char *buf, t_format format);
+
+// Log
+int		pl_log_init(t_log *log, int ring_total, t_tick start_time,
+			t_format format);
+void	pl_log_push(t_log *log, int id, t_state state);
+void	pl_log_halt(t_log *log, int id, t_state state);
+void	pl_log_stop(t_log *log);
+void	pl_log_flush(t_log *log, int final);
 
 // Utils
 int		ft_atoi(const char *str);
 int		ft_isdigit_str(char *str);
-time_t	pl_get_time(void);
-void	pl_usleep(time_t sec);
+void	*pl_alloc_lines(size_t count, size_t size);
+
+// Clock
+t_tick	pl_now(void);
+long	pl_tick_to_ms(t_tick tick);
+void	pl_nap(t_rules *rules, t_tick deadline, t_tick spin);
+void	pl_futex_wait(atomic_int *word, int value, t_tick deadline);
+void	pl_futex_wake(atomic_int *word);
 
 #endif
\ No newline at end of file
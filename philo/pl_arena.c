@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_arena.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:31:40 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:31:40 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Hand out an array from the arena, starting on a cache line
+ * @param arena The arena
+ * @param count Number of elements
+ * @param size Size of one element
+ * 
+ * @details
+ * With a NULL base, only count how much would be handed out.
+ * 
+ * @return The array, NULL when only counting.
+*/
+static void	*pl_arena_take(t_arena *arena, size_t count, size_t size)
+{
+	void	*ptr;
+
+	ptr = NULL;
+	if (arena->base != NULL)
+		ptr = arena->base + arena->used;
+	size = (count * size + PL_CACHE_LINE - 1) & ~(size_t)(PL_CACHE_LINE - 1);
+	arena->used += size;
+	return (ptr);
+}
+
+/**
+ * @brief Carve the per seat state out of the arena
+ * @param sim The simulation struct
+ * 
+ * @details
+ * Called twice: once with no mapping to size it, once to hand it out.
+*/
+static void	pl_arena_carve(t_simulation *sim)
+{
+	size_t	total;
+
+	total = sim->rules->philo_total;
+	sim->arena.used = 0;
+	sim->forks = pl_arena_take(&sim->arena, total, sizeof(t_fork));
+	sim->philos = pl_arena_take(&sim->arena, total, sizeof(t_philo));
+	sim->rules->log.rings = pl_arena_take(&sim->arena, total, sizeof(t_ring));
+	sim->deadlines.nodes = pl_arena_take(&sim->arena, total,
+			sizeof(t_heap_node));
+	sim->deadlines.size = 0;
+	sim->pool.coros = NULL;
+	if (sim->rules->opts.engine == CORO)
+		sim->pool.coros = pl_arena_take(&sim->arena, total, sizeof(t_coro));
+}
+
+/**
+ * @brief Map the arena that holds every seat's state
+ * @param sim The simulation struct
+ * 
+ * @details
+ * A single anonymous mapping instead of a malloc per array: it comes
+ * zero-filled, so whatever starts out at 0 (ring indexes, counters, and
+ * with glibc the mutexes and condition variables themselves) costs
+ * nothing, and no page is backed until a seat is set up on it (see
+ * pl_arena_fill). With --hugepages, it's rounded up to whole huge pages
+ * and the kernel is asked to back it with them, fewer TLB misses on a
+ * big table. If it refuses, the simulation goes on with small pages.
+ * 
+ * @return 1 on success, 0 if the arena can't be mapped.
+*/
+int	pl_arena_init(t_simulation *sim)
+{
+	t_arena	*arena;
+
+	arena = &sim->arena;
+	arena->base = NULL;
+	pl_arena_carve(sim);
+	arena->size = arena->used;
+	if (sim->rules->opts.huge)
+		arena->size = (arena->size + ARENA_HUGE - 1)
+			& ~(size_t)(ARENA_HUGE - 1);
+	arena->base = mmap(NULL, arena->size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (arena->base == MAP_FAILED)
+	{
+		arena->base = NULL;
+		return (pl_show_error(ARENA_FAILED, sim->rules->philo_total));
+	}
+	if (sim->rules->opts.huge
+		&& madvise(arena->base, arena->size, MADV_HUGEPAGE) != 0)
+		pl_rt_warn("--hugepages", errno);
+	pl_arena_carve(sim);
+	return (1);
+}
+
+/**
+ * @brief Tear down every lock, then unmap the arena, timing it
+ * @param sim The simulation struct
+ * 
+ * @details
+ * Every lock has been torn down by the end, the run queues' and the
+ * waiter's too: with LOCKSTAT=1, that's when the contention report is
+ * printed.
+ * 
+ * @attention Shall call once every philo, worker and monitor has been
+ *            joined. Nothing in the arena may be used after.
+*/
+void	pl_arena_free(t_simulation *sim)
+{
+	t_tick	start;
+	int		i;
+
+	if (sim->arena.base == NULL)
+		return ;
+	start = pl_now();
+	if (sim->rules->opts.fork->destroy != NULL)
+		sim->rules->opts.fork->destroy(sim);
+	i = -1;
+	while (++i < sim->rules->philo_total)
+	{
+		pl_mutex_destroy(&sim->forks[i].lock, &sim->lockstat, LOCK_FORK, i);
+		pthread_cond_destroy(&sim->forks[i].cond);
+		pl_mutex_destroy(&sim->philos[i].last_ate_lock, &sim->lockstat,
+			LOCK_LAST_ATE, i);
+		pl_mutex_destroy(&sim->philos[i].meal_count_lock, &sim->lockstat,
+			LOCK_MEAL_COUNT, i);
+	}
+	pl_mutex_destroy(&sim->rules->locks.full_lock, &sim->lockstat,
+		LOCK_FULL, 0);
+	munmap(sim->arena.base, sim->arena.size);
+	sim->arena.base = NULL;
+	sim->arena.teardown = pl_now() - start;
+	pl_lockstat_report(&sim->lockstat);
+}
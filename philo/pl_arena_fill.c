@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_arena_fill.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:31:40 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:31:40 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Set up a share of the seats
+ * @param arg The share
+*/
+static void	*pl_arena_filler(void *arg)
+{
+	t_fill	*fill;
+	int		i;
+
+	fill = arg;
+	i = fill->lo - 1;
+	while (++i < fill->hi)
+	{
+		pl_fork_init(fill->sim, i);
+		pl_philo_init(fill->sim, &fill->sim->philos[i], i);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Count the shares a table is cut into
+ * @param seats Number of seats
+ * 
+ * @return One per CPU, at most ARENA_FILL_MAX, and no share under
+ *         ARENA_CHUNK seats (at least one share).
+*/
+static int	pl_arena_shares(int seats)
+{
+	int	total;
+
+	total = sysconf(_SC_NPROCESSORS_ONLN);
+	if (total > seats / ARENA_CHUNK)
+		total = seats / ARENA_CHUNK;
+	if (total > ARENA_FILL_MAX)
+		total = ARENA_FILL_MAX;
+	if (total < 1)
+		total = 1;
+	return (total);
+}
+
+/**
+ * @brief Set up every fork and philo
+ * @param sim The simulation struct, its arena mapped
+ * 
+ * @details
+ * A big table is cut into contiguous shares (see pl_arena_shares), set
+ * up by threads of their own. Besides going faster, a page ends up on the
+ * NUMA node of the thread that first touches it: with --affinity, each
+ * filler is pinned where the philo at the start of its share will be.
+ * The main thread takes the first share, and any share whose thread
+ * can't be spawned.
+*/
+void	pl_arena_fill(t_simulation *sim)
+{
+	t_fill	fills[ARENA_FILL_MAX];
+	int		total;
+	int		i;
+
+	total = pl_arena_shares(sim->rules->philo_total);
+	i = -1;
+	while (++i < total)
+	{
+		fills[i].sim = sim;
+		fills[i].lo = (long)sim->rules->philo_total * i / total;
+		fills[i].hi = (long)sim->rules->philo_total * (i + 1) / total;
+		if (i > 0 && pthread_create(&fills[i].me, NULL, &pl_arena_filler,
+				&fills[i]) == 0)
+			pl_rt_pin(sim->rules, fills[i].me, fills[i].lo,
+				sim->rules->philo_total);
+		else if (i > 0)
+			fills[i].sim = pl_arena_filler(&fills[i]);
+	}
+	pl_arena_filler(&fills[0]);
+	while (--i > 0)
+	{
+		if (fills[i].sim != NULL)
+			pthread_join(fills[i].me, NULL);
+	}
+}
@@ -0,0 +1,71 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_clock.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:14:10 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:11:51 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Get the current time on the monotonic clock
+ * 
+ * @details
+ * CLOCK_MONOTONIC is never stepped by NTP or the user, so a philo can't
+ * be "killed" by a clock adjustment. glibc serves clock_gettime through
+ * the vDSO, so this is a plain memory read, not a syscall.
+ * 
+ * @return The time in ticks (ns)
+*/
+t_tick	pl_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((t_tick)ts.tv_sec * TICK_S + ts.tv_nsec);
+}
+
+/**
+ * @brief Convert ticks to milliseconds (rounded down)
+ * @param tick Duration in ticks
+ * 
+ * @return The duration in ms
+*/
+long	pl_tick_to_ms(t_tick tick)
+{
+	return (tick / TICK_MS);
+}
+
+/**
+ * @brief Sleep until an absolute deadline, unless the simulation ends
+ *        first
+ * @param rules The simulation rules
+ * @param deadline The time to wake up (ticks)
+ * @param spin Stop sleeping this long before the deadline and yield the
+ *             CPU until it instead (ticks, 0 to only sleep)
+ * 
+ * @details
+ * The sleep is a futex wait on the simulation state, with the deadline as
+ * timeout: pl_end_simulation_state wakes every napping thread with one
+ * call, the others sleep until their deadline as with clock_nanosleep. A
+ * sleep costs one wake up instead of the two thousand a second of the old
+ * usleep(500) polling, and since the deadline is absolute, a wake up that
+ * comes late doesn't push back the next one. The loop only repeats when a
+ * signal or a spurious wake up interrupts the sleep. The kernel may still
+ * wake us a little late (timer slack), which is what the spin budget buys
+ * back.
+*/
+void	pl_nap(t_rules *rules, t_tick deadline, t_tick spin)
+{
+	while (pl_now() < deadline - spin
+		&& atomic_load_explicit(&rules->sim_state, memory_order_acquire) == RUN)
+		pl_futex_wait(&rules->sim_state, RUN, deadline - spin);
+	while (pl_now() < deadline
+		&& atomic_load_explicit(&rules->sim_state, memory_order_acquire) == RUN)
+		sched_yield();
+}
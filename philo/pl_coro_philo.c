@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_coro_philo.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:38:44 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:00:20 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Sleep until the deadline, handing the worker over meanwhile
+ * @param coro The coroutine
+ * @param deadline Absolute time to wake up at
+*/
+static void	pl_coro_sleep(t_coro *coro, t_tick deadline)
+{
+	coro->wake = deadline;
+	coro->park = PARK_SLEEP;
+	swapcontext(&coro->ctx, &coro->worker->ctx);
+}
+
+/**
+ * @brief Take a fork, parking until it's handed over if it's in use
+ * @param coro The coroutine
+ * @param fork The fork
+*/
+static void	pl_coro_take(t_coro *coro, t_fork *fork)
+{
+	pl_mutex_lock(&fork->lock);
+	if (fork->in_use == 0)
+	{
+		fork->in_use = 1;
+		pl_mutex_unlock(&fork->lock);
+	}
+	else
+	{
+		pl_mutex_unlock(&fork->lock);
+		coro->fork = fork;
+		coro->park = PARK_FORK;
+		swapcontext(&coro->ctx, &coro->worker->ctx);
+	}
+	pl_declare_state(coro->philo, FORK);
+}
+
+/**
+ * @brief Put a fork down, or hand it straight to the neighbour waiting
+ *        for it, who then runs on this worker
+ * @param coro The coroutine
+ * @param fork The fork
+*/
+static void	pl_coro_put(t_coro *coro, t_fork *fork)
+{
+	t_coro	*waiter;
+
+	pl_mutex_lock(&fork->lock);
+	waiter = fork->waiter;
+	fork->waiter = NULL;
+	if (waiter == NULL)
+		fork->in_use = 0;
+	pl_mutex_unlock(&fork->lock);
+	if (waiter != NULL)
+		pl_runq_push(&coro->worker->runq, waiter->philo->id);
+}
+
+/**
+ * @brief Eat routine of a philo coroutine, same as pl_eat
+ * @param coro The coroutine
+ * 
+ * @return The time the meal ended
+*/
+static t_tick	pl_coro_eat(t_coro *coro)
+{
+	t_philo	*philo;
+	t_tick	done;
+
+	philo = coro->philo;
+	pl_trace_mark(philo->rules, &philo->trace, SPAN_WAIT, -1);
+	pl_coro_take(coro, philo->left_fork);
+	pl_coro_take(coro, philo->right_fork);
+	done = pl_now();
+	if (pl_get_sim_state(philo) != END)
+	{
+		pl_set_last_ate(philo, done);
+		done += philo->rules->time_to_eat * TICK_MS;
+		pl_declare_state(philo, EAT);
+		pl_add_meal(philo);
+		pl_full_tracker(philo);
+		pl_coro_sleep(coro, done);
+	}
+	pl_coro_put(coro, philo->left_fork);
+	pl_coro_put(coro, philo->right_fork);
+	return (done);
+}
+
+/**
+ * @brief The routine of a philo coroutine, same as pl_routine
+ * @param hi High half of the coroutine's address
+ * @param lo Low half of it
+ * 
+ * @details
+ * makecontext only passes ints, hence the address in two halves.
+ * Left fork then right fork, odd philos start half a meal late, as with
+ * the "naive" strategy, unless they wait for their slots instead
+ * (--sched=adaptive). A philo alone at the table waits for his only
+ * fork a second time, until the simulation ends.
+*/
+void	pl_coro_main(unsigned int hi, unsigned int lo)
+{
+	t_coro	*coro;
+	t_philo	*philo;
+	t_tick	done;
+
+	coro = (t_coro *)((uintptr_t)hi << 16 << 16 | lo);
+	philo = coro->philo;
+	pl_trace_mark(philo->rules, &philo->trace, SPAN_THINK, -1);
+	if (philo->id % 2 != 0 && philo->rules->opts.sched == STAGGER)
+		pl_coro_sleep(coro, philo->rules->start_time
+			+ philo->rules->time_to_eat * TICK_MS / 2);
+	while (pl_get_sim_state(philo) != END)
+	{
+		if (philo->rules->opts.sched == ADAPTIVE)
+			pl_coro_sleep(coro, pl_sched_next(philo));
+		done = pl_coro_eat(coro);
+		pl_declare_state(philo, SLEEP);
+		pl_coro_sleep(coro, done + philo->rules->time_to_sleep * TICK_MS);
+		pl_declare_state(philo, THINK);
+	}
+	coro->park = PARK_DONE;
+	swapcontext(&coro->ctx, &coro->worker->ctx);
+}
@@ -0,0 +1,165 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_des.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:36:06 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:36:06 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Print an event of the discrete event engine, at the virtual time
+ * @param des The engine
+ * @param id The philo
+ * @param state The new state of the philo
+ * 
+ * @details
+ * Same formatter as the logger, the simulation starting at 0, so the
+ * output can't be told apart from a run on the wall clock. Like the
+ * logger once the simulation has ended, nothing is printed after the
+ * meal that leaves the last philo full, even within the same step.
+*/
+void	pl_des_log(t_des *des, int id, t_state state)
+{
+	t_event	event;
+
+	if (des->full == des->rules->philo_total)
+		return ;
+	if (des->len > LOG_BUF_SIZE - 128)
+	{
+		write(STDOUT_FILENO, des->buf, des->len);
+		des->len = 0;
+	}
+	event.time = des->now;
+	event.id = id;
+	event.state = state;
+	des->len += pl_format_event(des->buf + des->len, &event, 0,
+			des->rules->opts.format);
+}
+
+/**
+ * @brief Set up the table at virtual time 0
+ * @param des The engine
+ * @param rules The simulation rules
+ * 
+ * @details
+ * Every philo starts out reaching for his forks, odd philos only after
+ * half a meal, as they do with the "naive" strategy.
+ * 
+ * @return 1 on success, 0 if an allocation failed.
+*/
+static int	pl_des_init(t_des *des, t_rules *rules)
+{
+	int	i;
+
+	memset(des, 0, sizeof(t_des));
+	des->rules = rules;
+	des->philos = calloc(rules->philo_total, sizeof(t_des_philo));
+	des->forks = malloc(rules->philo_total * sizeof(t_des_fork));
+	des->buf = malloc(LOG_BUF_SIZE);
+	if (des->philos == NULL || des->forks == NULL || des->buf == NULL
+		|| pl_heap_init(&des->events, rules->philo_total) == 0
+		|| pl_heap_init(&des->deadlines, rules->philo_total) == 0)
+		return (0);
+	des->len = pl_format_header(des->buf, rules->opts.format);
+	i = -1;
+	while (++i < rules->philo_total)
+	{
+		des->philos[i].state = THINK;
+		des->forks[i].holder = -1;
+		des->forks[i].waiter = -1;
+		pl_heap_push(&des->events, (i % 2) * rules->time_to_eat * TICK_MS
+			/ 2, i);
+		pl_heap_push(&des->deadlines, rules->time_to_die * TICK_MS, i);
+	}
+	return (1);
+}
+
+/**
+ * @brief Check if someone starves before the next event
+ * @param des The engine
+ * 
+ * @details
+ * Same as pl_check_dead: refresh the root of the deadlines until its key
+ * is the real deadline. A philo dies once the time is past his deadline,
+ * so an event due right on it still comes first.
+ * 
+ * @return 1 if the philo at the root died (and it's printed), 0 otherwise.
+*/
+static int	pl_des_dead(t_des *des)
+{
+	t_heap_node	*root;
+	t_tick		deadline;
+	t_tick		die;
+
+	root = &des->deadlines.nodes[0];
+	die = des->rules->time_to_die * TICK_MS;
+	deadline = des->philos[root->val].last_ate + die;
+	while (deadline > root->key)
+	{
+		pl_heap_update_root(&des->deadlines, deadline);
+		deadline = des->philos[root->val].last_ate + die;
+	}
+	if (des->events.size > 0 && des->events.nodes[0].key <= deadline)
+		return (0);
+	des->now = deadline + 1;
+	pl_des_log(des, root->val, DIED);
+	return (1);
+}
+
+/**
+ * @brief Print the meals eaten and the virtual time to stderr (--report)
+ * @param des The engine, stopped
+*/
+static void	pl_des_report(t_des *des)
+{
+	int		i;
+	long	meals;
+
+	i = -1;
+	meals = 0;
+	while (++i < des->rules->philo_total)
+		meals += des->philos[i].meals;
+	fprintf(stderr, "engine=des philos=%d meals=%ld virtual=%.3fs "
+		"meals/s=%.1f\n", des->rules->philo_total, meals,
+		(double)des->now / TICK_S, (double)meals * TICK_S / des->now);
+}
+
+/**
+ * @brief Run the simulation as discrete events (--engine=des)
+ * @param rules The simulation rules
+ * 
+ * @details
+ * Nobody sleeps: the virtual time jumps to the next event, which is
+ * handled by the same eat / sleep / think cycle, until someone starves
+ * or everyone is full. A scenario that takes minutes on the wall clock
+ * is done as fast as its output can be written.
+*/
+void	pl_des_run(t_rules *rules)
+{
+	t_des	des;
+
+	if (pl_des_init(&des, rules) != 0)
+	{
+		while (des.full < rules->philo_total && pl_des_dead(&des) == 0)
+		{
+			des.now = des.events.nodes[0].key;
+			pl_des_step(&des, des.events.nodes[0].val);
+		}
+		write(STDOUT_FILENO, des.buf, des.len);
+		if (rules->opts.report)
+			pl_des_report(&des);
+	}
+	else
+		pl_show_error(ENGINE_FAILED, rules->philo_total);
+	free(des.philos);
+	free(des.forks);
+	free(des.buf);
+	free(des.events.nodes);
+	free(des.deadlines.nodes);
+}
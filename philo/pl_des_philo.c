@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_des_philo.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:35:51 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:35:51 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Pick up a fork that's on the table
+ * @param des The engine
+ * @param id The philo
+ * @param fork The fork
+*/
+static void	pl_des_grab(t_des *des, int id, int fork)
+{
+	des->forks[fork].holder = id;
+	des->philos[id].forks++;
+	pl_des_log(des, id, FORK);
+}
+
+/**
+ * @brief Reach for the forks still missing, and eat if both are in hand
+ * @param des The engine
+ * @param id The philo
+ * 
+ * @details
+ * Left fork then right fork, as "naive" does. A fork that is taken leaves
+ * the philo waiting for it, with no event: he's handed the fork when it's
+ * put down (pl_des_put). Same as pl_eat, the meal is counted and checked
+ * against the optional number of meals as soon as it starts.
+ * 
+ * @return 1 if the philo started eating, 0 if he's waiting for a fork.
+*/
+int	pl_des_take(t_des *des, int id)
+{
+	t_des_philo	*philo;
+	int			fork;
+
+	philo = &des->philos[id];
+	while (philo->forks < 2)
+	{
+		fork = id;
+		if (philo->forks == 1)
+			fork = (id + des->rules->philo_total - 1) % des->rules->philo_total;
+		if (des->forks[fork].holder != -1)
+		{
+			des->forks[fork].waiter = id;
+			return (0);
+		}
+		pl_des_grab(des, id, fork);
+	}
+	philo->state = EAT;
+	philo->last_ate = des->now;
+	philo->meals++;
+	pl_des_log(des, id, EAT);
+	if (philo->meals == des->rules->iteration)
+		des->full++;
+	return (1);
+}
+
+/**
+ * @brief Put a fork down, straight into the hand of whoever waits for it
+ * @param des The engine
+ * @param fork The fork
+ * 
+ * @details
+ * If the fork completes the waiter's pair, his meal starts now and ends
+ * with a new event.
+*/
+static void	pl_des_put(t_des *des, int fork)
+{
+	int	waiter;
+
+	waiter = des->forks[fork].waiter;
+	des->forks[fork].holder = -1;
+	if (waiter == -1)
+		return ;
+	des->forks[fork].waiter = -1;
+	pl_des_grab(des, waiter, fork);
+	if (pl_des_take(des, waiter))
+		pl_heap_push(&des->events,
+			des->now + des->rules->time_to_eat * TICK_MS, waiter);
+}
+
+/**
+ * @brief Handle the event of the philo at the root of the events
+ * @param des The engine, now set to the time of the event
+ * @param id The philo
+ * 
+ * @details
+ * End of a meal: sleep, and put the forks down.
+ * End of a nap: think, and reach for the forks.
+ * End of the stagger: reach for the forks.
+ * The root is moved to the philo's next event, or dropped if he's left
+ * waiting for a fork. It's done before anyone is handed a fork, as that
+ * pushes another event.
+*/
+void	pl_des_step(t_des *des, int id)
+{
+	t_des_philo	*philo;
+
+	philo = &des->philos[id];
+	if (philo->state == EAT)
+	{
+		philo->state = SLEEP;
+		philo->forks = 0;
+		pl_des_log(des, id, SLEEP);
+		pl_heap_update_root(&des->events,
+			des->now + des->rules->time_to_sleep * TICK_MS);
+		pl_des_put(des, id);
+		pl_des_put(des, (id + des->rules->philo_total - 1)
+			% des->rules->philo_total);
+		return ;
+	}
+	if (philo->state == SLEEP)
+		pl_des_log(des, id, THINK);
+	philo->state = THINK;
+	if (pl_des_take(des, id))
+		pl_heap_update_root(&des->events,
+			des->now + des->rules->time_to_eat * TICK_MS);
+	else
+		pl_heap_pop(&des->events);
+}
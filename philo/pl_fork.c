@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_fork.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:21:50 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:33:57 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Find a fork strategy by name
+ * @param name The name given to --fork
+ * 
+ * @details
+ * naive	Left fork then right fork, odd philos start late so that not
+ * 			everyone holds their left fork at once
+ * ordered	Lower address first: the forks are ordered, so no cycle of
+ * 			philos waiting on each other can form
+ * trylock	Left fork, then try the right one. On failure put the left
+ * 			back and back off (exponentially) before trying again
+ * waiter	A waiter hands both forks at once, when both are free, to the
+ * 			hungriest philo first
+ * chandy	Chandy-Misra: a fork goes to a hungry neighbour only once it
+ * 			has been eaten with (dirty), and it's cleaned on the way
+ * fifo		Like naive, but a fork is handed over to the philos in the
+ * 			order they queued for it
+ * 
+ * Every strategy but chandy starts staggered. ordered and trylock still
+ * don't queue: on an odd table near its limit (5 800 200 200), a philo
+ * back from sleeping can win the second fork from one who has waited
+ * longer, round after round, until he starves. That's what they are,
+ * --sched=adaptive keeps them alive there.
+ * 
+ * @return The strategy, NULL if there's no strategy with that name.
+*/
+const t_fork_strategy	*pl_fork_strategy(char *name)
+{
+	static const t_fork_strategy	strategies[] = {
+	{"naive", 1, NULL, &pl_take_naive, &pl_put_forks, NULL},
+	{"ordered", 1, NULL, &pl_take_ordered, &pl_put_forks, NULL},
+	{"trylock", 1, NULL, &pl_take_trylock, &pl_put_forks, NULL},
+	{"waiter", 1, &pl_waiter_init, &pl_take_waiter, &pl_put_waiter,
+		&pl_waiter_destroy},
+	{"chandy", 0, NULL, &pl_take_chandy, &pl_put_chandy, NULL},
+	{"fifo", 1, NULL, &pl_take_fifo, &pl_put_fifo, NULL},
+	{NULL, 0, NULL, NULL, NULL, NULL}};
+	int								i;
+
+	i = 0;
+	while (strategies[i].name != NULL && strcmp(strategies[i].name, name))
+		i++;
+	if (strategies[i].name == NULL)
+		return (NULL);
+	return (&strategies[i]);
+}
+
+/**
+ * @brief Function to handle the forks
+ * @param philo The philo struct
+ * @param act Fork action. take: Take both forks; return: Put them back.
+ * 
+ * @details
+ * How the forks are taken depends on the fork strategy (--fork). Taking
+ * them is timed, the longest wait is kept for the report.
+ * 
+ * @return 0 if the strategy gave up taking them as the simulation ended
+ *         (it holds neither), 1 otherwise.
+*/
+int	pl_fork_action(t_philo *philo, t_fork_action act)
+{
+	t_tick	start;
+	int		held;
+
+	held = 1;
+	if (act == TAKE)
+	{
+		start = pl_now();
+		held = philo->rules->opts.fork->take(philo);
+		start = pl_now() - start;
+		if (start > philo->wait_max)
+			philo->wait_max = start;
+	}
+	else if (act == RETURN)
+		philo->rules->opts.fork->put(philo);
+	return (held);
+}
+
+/**
+ * @brief Put both forks back (unlock them)
+ * @param philo The philo struct
+*/
+void	pl_put_forks(t_philo *philo)
+{
+	pl_mutex_unlock(&philo->left_fork->lock);
+	pl_mutex_unlock(&philo->right_fork->lock);
+}
@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_fork_chandy.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:21:50 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:21:50 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Get a fork from the neighbour, if he doesn't have it already
+ * @param philo The philo asking for it
+ * @param fork The fork
+ * 
+ * @details
+ * The neighbour keeps a clean fork (he hasn't eaten with it yet) and a
+ * fork he is eating with. Anything else he hands over, cleaned. Once the
+ * simulation ends, the philo stops waiting: a neighbour giving up or
+ * putting his forks down wakes him (see pl_chandy_release).
+ * 
+ * @return 1 if the fork is ours, 0 if the simulation ended first.
+*/
+static int	pl_chandy_grab(t_philo *philo, t_fork *fork)
+{
+	int	ended;
+
+	pl_mutex_lock(&fork->lock);
+	ended = (pl_get_sim_state(philo) == END);
+	while (!ended && fork->owner != philo->id
+		&& (fork->dirty == 0 || fork->in_use))
+	{
+		pl_cond_wait(&fork->cond, &fork->lock);
+		ended = (pl_get_sim_state(philo) == END);
+	}
+	if (!ended && fork->owner != philo->id)
+	{
+		fork->owner = philo->id;
+		fork->dirty = 0;
+	}
+	pl_mutex_unlock(&fork->lock);
+	return (!ended);
+}
+
+/**
+ * @brief Start eating with a fork, if it's still ours
+ * @param fork The fork
+ * @param id The philo
+ * 
+ * @return 1 if the fork is now in use, 0 if a neighbour took it meanwhile.
+*/
+static int	pl_chandy_pin(t_fork *fork, int id)
+{
+	int	pinned;
+
+	pl_mutex_lock(&fork->lock);
+	pinned = (fork->owner == id);
+	if (pinned)
+		fork->in_use = 1;
+	pl_mutex_unlock(&fork->lock);
+	return (pinned);
+}
+
+/**
+ * @brief Stop using a fork, without giving up its ownership
+ * @param fork The fork
+ * @param id The philo
+ * @param dirty Whether it has been eaten with
+ * 
+ * @details
+ * A fork that isn't the philo's (anymore) is left as it is, the
+ * neighbours waiting on it are only woken up.
+*/
+static void	pl_chandy_release(t_fork *fork, int id, int dirty)
+{
+	pl_mutex_lock(&fork->lock);
+	if (fork->owner == id)
+	{
+		fork->in_use = 0;
+		if (dirty)
+			fork->dirty = 1;
+	}
+	pthread_cond_broadcast(&fork->cond);
+	pl_mutex_unlock(&fork->lock);
+}
+
+/**
+ * @brief Gather both forks, Chandy-Misra style
+ * @param philo The philo struct
+ * 
+ * @details
+ * A dirty fork we already own can be taken by a hungry neighbour while we
+ * wait for the other one. So once both have been gathered, pin them, and
+ * start over if one of them is gone.
+ * Every fork starts dirty at the lower id of its two philos (see
+ * pl_fork_init), so nobody waits on a cycle of clean forks.
+ * If the simulation ends while waiting, whatever forks the philo got are
+ * left dirty for the neighbours, who are woken up to give up too.
+ * 
+ * @return 1 if the forks are held, 0 if the simulation ended first.
+*/
+int	pl_take_chandy(t_philo *philo)
+{
+	while (pl_chandy_grab(philo, philo->left_fork)
+		&& pl_chandy_grab(philo, philo->right_fork))
+	{
+		if (pl_chandy_pin(philo->left_fork, philo->id))
+		{
+			if (pl_chandy_pin(philo->right_fork, philo->id))
+			{
+				pl_declare_state(philo, FORK);
+				pl_declare_state(philo, FORK);
+				return (1);
+			}
+			pl_chandy_release(philo->left_fork, philo->id, 0);
+		}
+	}
+	pl_chandy_release(philo->left_fork, philo->id, 1);
+	pl_chandy_release(philo->right_fork, philo->id, 1);
+	return (0);
+}
+
+/**
+ * @brief Done eating, both forks are dirty now
+ * @param philo The philo struct
+*/
+void	pl_put_chandy(t_philo *philo)
+{
+	pl_chandy_release(philo->left_fork, philo->id, 1);
+	pl_chandy_release(philo->right_fork, philo->id, 1);
+}
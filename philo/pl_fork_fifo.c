@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_fork_fifo.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:31:17 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:33:57 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Queue up for a fork and wait until it's handed over
+ * @param fork The fork
+ * 
+ * @details
+ * Whoever asks first gets the fork first: each philo draws a ticket and
+ * the fork serves the tickets in order. The mutex only guards the queue,
+ * nobody holds it while eating, so a release can't be stolen by whoever
+ * the kernel happens to wake up first.
+*/
+static void	pl_fifo_grab(t_fork *fork)
+{
+	unsigned long	ticket;
+	t_tick			start;
+
+	start = pl_now();
+	pl_mutex_lock(&fork->lock);
+	ticket = fork->ticket++;
+	fork->queued++;
+	if (fork->queued > fork->queue_max)
+		fork->queue_max = fork->queued;
+	while (fork->serving != ticket)
+		pl_cond_wait(&fork->cond, &fork->lock);
+	fork->wait_total += pl_now() - start;
+	pl_mutex_unlock(&fork->lock);
+}
+
+/**
+ * @brief Hand the fork over to the next philo in the queue
+ * @param fork The fork
+*/
+static void	pl_fifo_release(t_fork *fork)
+{
+	pl_mutex_lock(&fork->lock);
+	fork->serving++;
+	fork->queued--;
+	pthread_cond_broadcast(&fork->cond);
+	pl_mutex_unlock(&fork->lock);
+}
+
+/**
+ * @brief Queue for the left fork, then for the right one
+ * @param philo The philo struct
+ * 
+ * @details
+ * Same order as "naive" and the same stagger, but a fork put down goes
+ * to the neighbour that has been waiting for it, so the odd / even
+ * rhythm set by the stagger doesn't drift apart after a few rounds.
+ * 
+ * @return 1, the forks are held.
+*/
+int	pl_take_fifo(t_philo *philo)
+{
+	pl_fifo_grab(philo->left_fork);
+	pl_declare_state(philo, FORK);
+	pl_fifo_grab(philo->right_fork);
+	pl_declare_state(philo, FORK);
+	return (1);
+}
+
+/**
+ * @brief Hand both forks over to whoever queued for them next
+ * @param philo The philo struct
+*/
+void	pl_put_fifo(t_philo *philo)
+{
+	pl_fifo_release(philo->left_fork);
+	pl_fifo_release(philo->right_fork);
+}
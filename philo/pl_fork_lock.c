@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_fork_lock.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:21:50 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:11:51 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Lock the left fork, then the right fork
+ * @param philo The philo struct
+ * 
+ * @return 1, the forks are held.
+*/
+int	pl_take_naive(t_philo *philo)
+{
+	pl_mutex_lock(&philo->left_fork->lock);
+	pl_declare_state(philo, FORK);
+	pl_mutex_lock(&philo->right_fork->lock);
+	pl_declare_state(philo, FORK);
+	return (1);
+}
+
+/**
+ * @brief Lock the fork with the lower address first
+ * @param philo The philo struct
+ * 
+ * @details
+ * Every philo locks the forks in the same global order: the first philo
+ * reaches for his left fork first, everyone else for his right one. So
+ * the table can't fill up with philos holding one fork each.
+ * 
+ * @return 1, the forks are held.
+*/
+int	pl_take_ordered(t_philo *philo)
+{
+	t_fork	*first;
+	t_fork	*second;
+
+	first = philo->left_fork;
+	second = philo->right_fork;
+	if (second < first)
+	{
+		first = philo->right_fork;
+		second = philo->left_fork;
+	}
+	pl_mutex_lock(&first->lock);
+	pl_declare_state(philo, FORK);
+	pl_mutex_lock(&second->lock);
+	pl_declare_state(philo, FORK);
+	return (1);
+}
+
+/**
+ * @brief Lock the left fork and try the right one, backing off on failure
+ * @param philo The philo struct
+ * 
+ * @details
+ * Nobody ever waits on a fork while holding another, so there's no
+ * deadlock. The back off starts at BACKOFF_MIN and doubles up to
+ * BACKOFF_MAX, so that two neighbours don't keep colliding. Once the
+ * simulation ends, the back off doesn't nap anymore: every pass checks
+ * for it, and gives up.
+ * 
+ * @return 1 if the forks are held, 0 if the simulation ended first.
+*/
+int	pl_take_trylock(t_philo *philo)
+{
+	t_tick	backoff;
+
+	backoff = BACKOFF_MIN;
+	while (pl_get_sim_state(philo) != END)
+	{
+		pl_mutex_lock(&philo->left_fork->lock);
+		if (pl_mutex_trylock(&philo->right_fork->lock) == 0)
+		{
+			pl_declare_state(philo, FORK);
+			pl_declare_state(philo, FORK);
+			return (1);
+		}
+		pl_mutex_unlock(&philo->left_fork->lock);
+		pl_nap(philo->rules, pl_now() + backoff, 0);
+		if (backoff < BACKOFF_MAX)
+			backoff *= 2;
+	}
+	return (0);
+}
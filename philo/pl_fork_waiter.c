@@ -0,0 +1,126 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_fork_waiter.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:21:50 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:21:50 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Set up the waiter
+ * @param sim The simulation struct
+ * 
+ * @return 1 on success, 0 on error.
+*/
+int	pl_waiter_init(t_simulation *sim)
+{
+	t_waiter	*waiter;
+
+	waiter = &sim->rules->waiter;
+	pl_mutex_init(&waiter->lock);
+	if (pthread_cond_init(&waiter->cond, NULL) != 0)
+		return (pl_show_error(CREATE_MUT_FAILED, -1));
+	return (1);
+}
+
+/**
+ * @brief Send the waiter home
+ * @param sim The simulation struct
+ * 
+ * @attention Shall call once every philo has been joined.
+*/
+void	pl_waiter_destroy(t_simulation *sim)
+{
+	pl_mutex_destroy(&sim->rules->waiter.lock, &sim->lockstat, LOCK_WAITER,
+		0);
+	pthread_cond_destroy(&sim->rules->waiter.cond);
+}
+
+/**
+ * @brief Stake a claim on a fork, unless a hungrier philo has one
+ * @param fork The fork
+ * @param philo The philo
+ * @param since When he last ate
+ * 
+ * @details
+ * Whoever ate the longest ago is the hungriest, the lower id breaks a
+ * tie: a strict order, so claims can't go round the table in a cycle.
+*/
+static void	pl_waiter_claim(t_fork *fork, t_philo *philo, t_tick since)
+{
+	if (fork->claim == NULL || fork->claim == philo
+		|| since < fork->claim_since || (since == fork->claim_since
+			&& philo->id < fork->claim->id))
+	{
+		fork->claim = philo;
+		fork->claim_since = since;
+	}
+}
+
+/**
+ * @brief Ask the waiter for both forks
+ * @param philo The philo struct
+ * 
+ * @details
+ * The waiter hands both forks at once, once both are free and nobody
+ * hungrier is waiting for either: a philo never holds one fork while
+ * waiting for the other, so no chain of philos each waiting on his
+ * neighbour, and the hungriest one always eats next. The fields it uses
+ * are only touched under the waiter's lock, which stands in for the
+ * forks' own.
+ * 
+ * @return 1, the forks are held.
+*/
+int	pl_take_waiter(t_philo *philo)
+{
+	t_waiter	*waiter;
+	t_tick		since;
+
+	waiter = &philo->rules->waiter;
+	since = pl_get_last_ate(philo);
+	pl_mutex_lock(&waiter->lock);
+	while (1)
+	{
+		pl_waiter_claim(philo->left_fork, philo, since);
+		pl_waiter_claim(philo->right_fork, philo, since);
+		if (philo->left_fork->claim == philo && !philo->left_fork->in_use
+			&& philo->right_fork->claim == philo
+			&& !philo->right_fork->in_use)
+			break ;
+		pl_cond_wait(&waiter->cond, &waiter->lock);
+	}
+	philo->left_fork->in_use = 1;
+	philo->right_fork->in_use = 1;
+	philo->left_fork->claim = NULL;
+	philo->right_fork->claim = NULL;
+	pl_mutex_unlock(&waiter->lock);
+	pl_declare_state(philo, FORK);
+	pl_declare_state(philo, FORK);
+	return (1);
+}
+
+/**
+ * @brief Give both forks back to the waiter
+ * @param philo The philo struct
+ * 
+ * @details
+ * Everyone waiting is woken up: they wait on different forks, each checks
+ * his own.
+*/
+void	pl_put_waiter(t_philo *philo)
+{
+	t_waiter	*waiter;
+
+	waiter = &philo->rules->waiter;
+	pl_mutex_lock(&waiter->lock);
+	philo->left_fork->in_use = 0;
+	philo->right_fork->in_use = 0;
+	pthread_cond_broadcast(&waiter->cond);
+	pl_mutex_unlock(&waiter->lock);
+}
@@ -0,0 +1,158 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_format.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:29:09 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:29:09 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Get the message of a state
+ * @param state The state of the philo
+ * @param format The output format (not BIN)
+*/
+static const char	*pl_state_msg(t_state state, t_format format)
+{
+	static const char	*text[] = {PUR"has taken a fork\n"DEF,
+		GRN"is eating\n"DEF, CYN"is sleeping\n"DEF, YLW"is thinking\n"DEF,
+		RED"died\n"DEF};
+	static const char	*plain[] = {"has taken a fork\n", "is eating\n",
+		"is sleeping\n", "is thinking\n", "died\n"};
+	static const char	*csv[] = {"fork\n", "eat\n", "sleep\n", "think\n",
+		"died\n"};
+
+	if (state > DIED)
+		return ("");
+	if (format == PLAIN)
+		return (plain[state]);
+	if (format == CSV)
+		return (csv[state]);
+	return (text[state]);
+}
+
+/**
+ * @brief Write a number right aligned in a field of "width" characters
+ * @param buf Where to write
+ * @param n The number (not negative)
+ * @param width Minimum width of the field, padded with spaces
+ * 
+ * @return Number of characters written
+*/
+static int	pl_put_nbr(char *buf, long n, int width)
+{
+	int		len;
+	int		pad;
+	long	tmp;
+
+	len = 1;
+	tmp = n;
+	while (tmp >= 10)
+	{
+		tmp /= 10;
+		len++;
+	}
+	pad = 0;
+	while (pad + len < width)
+		buf[pad++] = ' ';
+	tmp = len;
+	while (tmp-- > 0)
+	{
+		buf[pad + tmp] = '0' + n % 10;
+		n /= 10;
+	}
+	return (pad + len);
+}
+
+/**
+ * @brief Format an event as a binary record
+ * @param buf Where to write
+ * @param event The event
+ * @param start The start time of the simulation
+ * 
+ * @details
+ * LOG_BIN_RECORD bytes, no padding, host byte order:
+ * u64 time since the start (us), u32 philo id (from 1), u8 state (t_state)
+ * 
+ * @return LOG_BIN_RECORD
+*/
+static int	pl_format_bin(char *buf, t_event *event, t_tick start)
+{
+	uint64_t	us;
+	uint32_t	id;
+
+	us = (event->time - start) / TICK_US;
+	id = event->id + 1;
+	memcpy(buf, &us, sizeof(us));
+	memcpy(buf + sizeof(us), &id, sizeof(id));
+	buf[sizeof(us) + sizeof(id)] = (uint8_t)event->state;
+	return (LOG_BIN_RECORD);
+}
+
+/**
+ * @brief Format an event
+ * @param buf Where to write, at least 64 bytes
+ * @param event The event
+ * @param start The start time of the simulation
+ * @param format The output format
+ * 
+ * @details
+ * TEXT is what printf("%8ld %3d ") + message would print. PLAIN drops the
+ * padding and the colours, CSV has the time in us instead of ms.
+ * 
+ * @return Number of bytes written
+*/
+int	pl_format_event(char *buf, t_event *event, t_tick start, t_format format)
+{
+	int			len;
+	int			text;
+	char		sep;
+	const char	*msg;
+
+	if (format == BIN)
+		return (pl_format_bin(buf, event, start));
+	text = (format == TEXT);
+	sep = ' ';
+	if (format == CSV)
+		sep = ',';
+	if (format == CSV)
+		len = pl_put_nbr(buf, (event->time - start) / TICK_US, 0);
+	else
+		len = pl_put_nbr(buf, pl_tick_to_ms(event->time - start), 8 * text);
+	buf[len++] = sep;
+	len += pl_put_nbr(buf + len, event->id + 1, 3 * text);
+	buf[len++] = sep;
+	msg = pl_state_msg(event->state, format);
+	while (*msg)
+		buf[len++] = *msg++;
+	return (len);
+}
+
+/**
+ * @brief Write what comes before the first event
+ * @param buf Where to write
+ * @param format The output format
+ * 
+ * @return Number of bytes written (only CSV has a header)
+*/
+int	pl_format_header(char *buf, t_format format)
+{
+	const char	*header;
+	int			len;
+
+	len = 0;
+	if (format != CSV)
+		return (0);
+	header = "time_us,id,state\n";
+	while (header[len])
+	{
+		buf[len] = header[len];
+		len++;
+	}
+	return (len);
+}
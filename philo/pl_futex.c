@@ -0,0 +1,46 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_futex.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:09:59 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:09:59 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Sleep while a word holds a value, until a deadline at most
+ * @param word The word
+ * @param value The value it holds as long as there's nothing to wake up for
+ * @param deadline Absolute time (monotonic clock) to give up at
+ * 
+ * @details
+ * FUTEX_WAIT_BITSET takes an absolute deadline on the monotonic clock,
+ * the same as pl_now. The kernel checks the word before going to sleep,
+ * so a wake up sent between the caller's check and the sleep isn't lost.
+ * Returns on a wake up, at the deadline, or early on a signal: callers
+ * check again.
+*/
+void	pl_futex_wait(atomic_int *word, int value, t_tick deadline)
+{
+	struct timespec	ts;
+
+	ts.tv_sec = deadline / TICK_S;
+	ts.tv_nsec = deadline % TICK_S;
+	syscall(SYS_futex, word, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, value,
+		&ts, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+/**
+ * @brief Wake every thread sleeping on a word
+ * @param word The word, changed by the caller beforehand
+*/
+void	pl_futex_wake(atomic_int *word)
+{
+	syscall(SYS_futex, word, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, INT_MAX,
+		NULL, NULL, 0);
+}
@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_heap.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:07:35 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:36:34 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Allocate an empty heap
+ * @param heap The heap
+ * @param capacity Maximum number of nodes
+ * 
+ * @return 1 on success, 0 if the allocation failed.
+*/
+int	pl_heap_init(t_heap *heap, int capacity)
+{
+	heap->size = 0;
+	heap->nodes = malloc(sizeof(t_heap_node) * capacity);
+	if (heap->nodes == NULL)
+		return (0);
+	return (1);
+}
+
+/**
+ * @brief Swap two nodes of the heap
+*/
+static void	pl_heap_swap(t_heap *heap, int a, int b)
+{
+	t_heap_node	tmp;
+
+	tmp = heap->nodes[a];
+	heap->nodes[a] = heap->nodes[b];
+	heap->nodes[b] = tmp;
+}
+
+/**
+ * @brief Push a node into the heap
+ * @param heap The heap
+ * @param key The deadline
+ * @param val The philo index
+ * 
+ * @details
+ * Append the node at the end and let it bubble up until its parent has
+ * a smaller (or equal) deadline.
+*/
+void	pl_heap_push(t_heap *heap, t_tick key, int val)
+{
+	int	i;
+
+	i = heap->size++;
+	heap->nodes[i].key = key;
+	heap->nodes[i].val = val;
+	while (i > 0 && heap->nodes[(i - 1) / 2].key > heap->nodes[i].key)
+	{
+		pl_heap_swap(heap, i, (i - 1) / 2);
+		i = (i - 1) / 2;
+	}
+}
+
+/**
+ * @brief Change the key of the root and sink it back into place
+ * @param heap The heap
+ * @param key The new deadline of the root
+ * 
+ * @details
+ * Deadlines only ever move forward (a philo's last ate time only grows),
+ * so the root can only sink, never rise.
+*/
+void	pl_heap_update_root(t_heap *heap, t_tick key)
+{
+	int	i;
+	int	min;
+
+	i = 0;
+	heap->nodes[0].key = key;
+	while (1)
+	{
+		min = i;
+		if (2 * i + 1 < heap->size
+			&& heap->nodes[2 * i + 1].key < heap->nodes[min].key)
+			min = 2 * i + 1;
+		if (2 * i + 2 < heap->size
+			&& heap->nodes[2 * i + 2].key < heap->nodes[min].key)
+			min = 2 * i + 2;
+		if (min == i)
+			break ;
+		pl_heap_swap(heap, i, min);
+		i = min;
+	}
+}
+
+/**
+ * @brief Remove the root of the heap
+ * @param heap The heap, not empty
+ * 
+ * @details
+ * The last node takes the place of the root and sinks back into place.
+*/
+void	pl_heap_pop(t_heap *heap)
+{
+	heap->size--;
+	if (heap->size == 0)
+		return ;
+	heap->nodes[0] = heap->nodes[heap->size];
+	pl_heap_update_root(heap, heap->nodes[0].key);
+}
@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_lockstat.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:06:12 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/18 00:06:12 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Keep a lock among the worst ones if it waited long enough
+ * @param lockstat The report
+ * @param rank The lock
+ * 
+ * @details
+ * top stays sorted, worst first: the lock goes in above the first one
+ * that waited less, pushing the last one out if it's full. When it's
+ * full and the lock waited no longer than the last one, it's left out,
+ * ranked only counts locks actually in top.
+*/
+static void	pl_lockstat_rank(t_lockstat *lockstat, t_lock_rank *rank)
+{
+	int	i;
+
+	i = lockstat->ranked;
+	if (i == LOCKSTAT_TOP && lockstat->top[i - 1].stats.wait_total
+		>= rank->stats.wait_total)
+		return ;
+	if (i == LOCKSTAT_TOP)
+		i--;
+	else
+		lockstat->ranked++;
+	while (i > 0 && lockstat->top[i - 1].stats.wait_total
+		< rank->stats.wait_total)
+	{
+		lockstat->top[i] = lockstat->top[i - 1];
+		i--;
+	}
+	lockstat->top[i] = *rank;
+}
+
+/**
+ * @brief Add the stats of a mutex to the report
+ * @param lockstat The report
+ * @param cls What it guarded
+ * @param id Which one it was
+ * @param stats Its stats
+ * 
+ * @details
+ * Totals add up over the class, maxima stay the max. Mutexes that
+ * were never contended are left out of the ranking.
+*/
+void	pl_lockstat_add(t_lockstat *lockstat, t_lock_class cls, int id,
+		t_lock_stats *stats)
+{
+	t_lock_stats	*sum;
+	t_lock_rank		rank;
+
+	sum = &lockstat->classes[cls];
+	lockstat->locks[cls]++;
+	sum->acquired += stats->acquired;
+	sum->contended += stats->contended;
+	sum->wait_total += stats->wait_total;
+	sum->hold_total += stats->hold_total;
+	if (stats->wait_max > sum->wait_max)
+		sum->wait_max = stats->wait_max;
+	if (stats->hold_max > sum->hold_max)
+		sum->hold_max = stats->hold_max;
+	if (stats->contended == 0)
+		return ;
+	rank.cls = cls;
+	rank.id = id;
+	rank.stats = *stats;
+	pl_lockstat_rank(lockstat, &rank);
+}
+
+/**
+ * @brief Print a row of the report
+ * @param name The class
+ * @param count The number of mutexes, or which one it is
+ * @param stats Their stats
+*/
+static void	pl_lockstat_row(char *name, long count, t_lock_stats *stats)
+{
+	fprintf(stderr, "%-11s %7ld %10ld %10ld %6.2f%% %11.3f %10.3f %11.3f "
+		"%10.3f\n", name, count, stats->acquired, stats->contended,
+		100.0 * stats->contended / (stats->acquired + (stats->acquired == 0)),
+		(double)stats->wait_total / TICK_MS,
+		(double)stats->wait_max / TICK_MS,
+		(double)stats->hold_total / TICK_MS,
+		(double)stats->hold_max / TICK_MS);
+}
+
+/**
+ * @brief Print the classes, the one waited for the longest first
+ * @param lockstat The report
+ * @param names The names of the classes
+ * 
+ * @details
+ * Classes never locked are left out.
+*/
+static void	pl_lockstat_classes(t_lockstat *lockstat, char **names)
+{
+	int	worst;
+	int	i;
+
+	worst = 0;
+	while (worst >= 0)
+	{
+		worst = -1;
+		i = -1;
+		while (++i < LOCK_CLASSES)
+		{
+			if (lockstat->locks[i] > 0 && lockstat->classes[i].acquired > 0
+				&& (worst < 0 || lockstat->classes[i].wait_total
+					> lockstat->classes[worst].wait_total))
+				worst = i;
+		}
+		if (worst < 0)
+			break ;
+		pl_lockstat_row(names[worst], lockstat->locks[worst],
+			&lockstat->classes[worst]);
+		lockstat->locks[worst] = 0;
+	}
+}
+
+/**
+ * @brief Print the contention report to stderr (LOCKSTAT=1)
+ * @param lockstat The stats of every mutex, all torn down
+ * 
+ * @details
+ * Classes come ranked by the time spent waiting for them, then the worst
+ * locks one by one, with which one they are instead of a count (the philo
+ * or fork, from 1 as in the log, or the worker). Times in ms.
+*/
+void	pl_lockstat_report(t_lockstat *lockstat)
+{
+	static char	*names[] = {"fork", "last_ate", "meal_count", "full",
+		"waiter", "runq"};
+	int			i;
+
+	if (PL_LOCKSTAT == 0)
+		return ;
+	fprintf(stderr, "lock contention, ranked by time waited (ms)\n");
+	fprintf(stderr, "%-11s %7s %10s %10s %7s %11s %10s %11s %10s\n", "lock",
+		"locks", "acquired", "contended", "rate", "wait", "wait_max", "hold",
+		"hold_max");
+	pl_lockstat_classes(lockstat, names);
+	if (lockstat->ranked > 0)
+		fprintf(stderr, "%-11s %7s\n", "worst", "which");
+	i = -1;
+	while (++i < lockstat->ranked)
+		pl_lockstat_row(names[lockstat->top[i].cls], lockstat->top[i].id
+			+ (lockstat->top[i].cls != LOCK_RUNQ), &lockstat->top[i].stats);
+}
@@ -0,0 +1,148 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_log.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:11:56 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:11:51 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Routine of the log writer thread
+ * @param arg The logger
+ * 
+ * @details
+ * Drain the rings every LOG_FLUSH_US until asked to stop, which wakes it
+ * up right away. The last flush is done once every philo has been joined,
+ * so nothing is left behind.
+*/
+static void	*pl_log_writer(void *arg)
+{
+	t_log	*log;
+
+	log = arg;
+	while (atomic_load_explicit(&log->stop, memory_order_acquire) == 0)
+	{
+		pl_log_flush(log, 0);
+		pl_futex_wait(&log->stop, 0, pl_now() + LOG_FLUSH_US * TICK_US);
+	}
+	pl_log_flush(log, 1);
+	return (NULL);
+}
+
+/**
+ * @brief Set up the logger and start the writer thread
+ * @param log The logger, its rings set up already
+ * @param ring_total Number of rings (one per philo)
+ * @param start_time The start time of the simulation
+ * @param format How events are printed
+ * 
+ * @details
+ * The rings are per seat state, they live in the simulation's arena and
+ * are set up along with their philo (see pl_arena_fill).
+ * 
+ * @return 1 if the logger is running. 0 if there's an error.
+*/
+int	pl_log_init(t_log *log, int ring_total, t_tick start_time,
+		t_format format)
+{
+	log->ring_total = ring_total;
+	log->staged = 0;
+	log->done = 0;
+	log->start_time = start_time;
+	log->format = format;
+	atomic_init(&log->halted, 0);
+	atomic_init(&log->stop, 0);
+	log->stage = malloc(sizeof(t_event) * ring_total * LOG_RING_SIZE);
+	log->buf = malloc(LOG_BUF_SIZE);
+	if (log->stage != NULL && log->buf != NULL)
+	{
+		log->len = pl_format_header(log->buf, format);
+		if (pthread_create(&log->writer, NULL, &pl_log_writer, log) == 0)
+			return (1);
+		pl_show_error(CREATE_THD_FAILED, -1);
+	}
+	free(log->stage);
+	free(log->buf);
+	return (0);
+}
+
+/**
+ * @brief Push an event into the philo's own ring
+ * @param log The logger
+ * @param id The philo ID
+ * @param state The new state of the philo
+ * 
+ * @details
+ * Before taking the timestamp, the philo publishes the time it started
+ * logging (pending). The writer never prints anything newer than the
+ * oldest pending time, which keeps the output in timestamp order even
+ * though the rings are filled concurrently.
+ * If the ring is full, wait for the writer to make some room.
+*/
+void	pl_log_push(t_log *log, int id, t_state state)
+{
+	t_ring	*ring;
+	size_t	tail;
+	t_event	*event;
+
+	if (atomic_load_explicit(&log->halted, memory_order_acquire) != 0)
+		return ;
+	ring = &log->rings[id];
+	atomic_store(&ring->pending, pl_now());
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	while (tail - atomic_load_explicit(&ring->head, memory_order_acquire)
+		>= LOG_RING_SIZE)
+		usleep(100);
+	event = &ring->events[tail & (LOG_RING_SIZE - 1)];
+	event->time = pl_now();
+	event->id = id;
+	event->state = state;
+	atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+	atomic_store_explicit(&ring->pending, LOG_IDLE, memory_order_release);
+}
+
+/**
+ * @brief Record the event that ends the log
+ * @param log The logger
+ * @param id The philo ID
+ * @param state DIED (printed) or FULL (not printed)
+ * 
+ * @details
+ * Only the first call wins. Every event that happened before the halt
+ * is still printed, everything after it is dropped.
+*/
+void	pl_log_halt(t_log *log, int id, t_state state)
+{
+	int	expected;
+
+	expected = 0;
+	if (atomic_compare_exchange_strong(&log->halted, &expected, 1) == 0)
+		return ;
+	log->halt.time = pl_now();
+	log->halt.id = id;
+	log->halt.state = state;
+	atomic_store_explicit(&log->halted, 2, memory_order_release);
+}
+
+/**
+ * @brief Stop the writer thread and release the logger (the rings are
+ *        the arena's)
+ * @param log The logger
+ * 
+ * @attention
+ * Call only once no philo can log anymore (every philo is joined).
+*/
+void	pl_log_stop(t_log *log)
+{
+	atomic_store_explicit(&log->stop, 1, memory_order_release);
+	pl_futex_wake(&log->stop);
+	pthread_join(log->writer, NULL);
+	free(log->stage);
+	free(log->buf);
+}
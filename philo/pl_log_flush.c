@@ -0,0 +1,162 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_log_flush.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:11:56 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:30:14 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Compute up to when (exclusive) the events can be printed
+ * @param log The logger
+ * @param final Whether this is the last flush
+ * 
+ * @details
+ * An event that is still being logged has a timestamp that is at least
+ * the pending time of its ring, and anything logged later will be stamped
+ * with the current time or later. So every event older than the minimum
+ * of those is already sitting in a ring.
+*/
+static t_tick	pl_log_watermark(t_log *log, int final)
+{
+	int		i;
+	t_tick	watermark;
+	t_tick	pending;
+
+	watermark = INT64_MAX;
+	if (final == 0)
+		watermark = pl_now();
+	i = -1;
+	while (++i < log->ring_total)
+	{
+		pending = atomic_load(&log->rings[i].pending);
+		if (pending != LOG_IDLE && pending < watermark)
+			watermark = pending;
+	}
+	return (watermark);
+}
+
+/**
+ * @brief Move every available event from the rings to the stage
+ * @param log The logger
+ * 
+ * @details
+ * The stage is as big as all the rings together. If it's full (a philo
+ * has been holding the watermark back for a while), leave the rest in
+ * the rings, the philos will wait for room.
+*/
+static void	pl_log_drain(t_log *log)
+{
+	int		i;
+	int		capacity;
+	t_ring	*ring;
+	size_t	head;
+	size_t	tail;
+
+	i = -1;
+	capacity = log->ring_total * LOG_RING_SIZE;
+	while (++i < log->ring_total)
+	{
+		ring = &log->rings[i];
+		head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+		tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+		while (head != tail && log->staged < capacity)
+			log->stage[log->staged++] = ring->events[head++
+				& (LOG_RING_SIZE - 1)];
+		atomic_store_explicit(&ring->head, head, memory_order_release);
+	}
+}
+
+/**
+ * @brief Sort the stage by time
+ * @param log The logger
+ * 
+ * @details
+ * Insertion sort: it's stable, and the stage is a handful of already
+ * sorted runs, one per ring, so it's cheap.
+*/
+static void	pl_log_sort(t_log *log)
+{
+	int		i;
+	int		j;
+	t_event	event;
+
+	i = 0;
+	while (++i < log->staged)
+	{
+		event = log->stage[i];
+		j = i - 1;
+		while (j >= 0 && log->stage[j].time > event.time)
+		{
+			log->stage[j + 1] = log->stage[j];
+			j--;
+		}
+		log->stage[j + 1] = event;
+	}
+}
+
+/**
+ * @brief Format the staged events older than the watermark and write
+ *        them out in as few write calls as possible
+ * @param log The logger
+ * @param watermark Events from this time on are kept for later
+*/
+static void	pl_log_emit(t_log *log, t_tick watermark)
+{
+	int	i;
+
+	i = 0;
+	while (i < log->staged && log->stage[i].time < watermark)
+	{
+		if (log->len > LOG_BUF_SIZE - 128)
+		{
+			write(STDOUT_FILENO, log->buf, log->len);
+			log->len = 0;
+		}
+		log->len += pl_format_event(log->buf + log->len, &log->stage[i++],
+				log->start_time, log->format);
+	}
+	log->staged -= i;
+	memmove(log->stage, log->stage + i, sizeof(t_event) * log->staged);
+}
+
+/**
+ * @brief Print every event that is safe to print
+ * @param log The logger
+ * @param final Whether this is the last flush (no philo is running)
+ * 
+ * @details
+ * Once the log is halted, print what happened up to the halt, then the
+ * halt itself if it's a death, and stop printing for good.
+*/
+void	pl_log_flush(t_log *log, int final)
+{
+	int		halted;
+	t_tick	watermark;
+
+	if (log->done)
+		return ;
+	halted = (atomic_load_explicit(&log->halted, memory_order_acquire) == 2);
+	watermark = pl_log_watermark(log, final);
+	pl_log_drain(log);
+	pl_log_sort(log);
+	if (halted && watermark > log->halt.time)
+	{
+		pl_log_emit(log, log->halt.time + 1);
+		if (log->halt.state == DIED)
+			log->len += pl_format_event(log->buf + log->len, &log->halt,
+					log->start_time, log->format);
+		log->done = 1;
+	}
+	else
+		pl_log_emit(log, watermark);
+	if (log->len > 0)
+		write(STDOUT_FILENO, log->buf, log->len);
+	log->len = 0;
+}
@@ -6,7 +6,7 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/10 15:14:32 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/02/22 12:12:57 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,7 +16,10 @@
  * @brief The main function
  * 
  * 1. Parse the inputs and set the rules
- * 2. Begin the simulation based on the rules set
+ * 2. Lock memory, and go real-time and pin threads if asked to
+ * 3. Begin the simulation based on the rules set, with threads or as
+ *    discrete events (--engine). With nobody at the table there's
+ *    nothing to set up, not even the arena: it ends quietly.
 */
 int	main(int ac, char **av)
 {
@@ -24,6 +27,12 @@ int	main(int ac, char **av)
 
 	if (pl_parse(--ac, ++av, &rules) == 0)
 		return (EXIT_FAILURE);
-	pl_begin_simulation(&rules);
+	if (pl_rt_init(&rules) == 0)
+		return (EXIT_FAILURE);
+	if (rules.philo_total > 0 && rules.opts.engine == DES)
+		pl_des_run(&rules);
+	else if (rules.philo_total > 0)
+		pl_begin_simulation(&rules);
+	free(rules.cpus.order);
 	return (EXIT_SUCCESS);
 }
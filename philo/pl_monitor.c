@@ -6,7 +6,7 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/15 15:34:46 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/02/24 19:06:20 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 23:11:51 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -19,7 +19,9 @@
  * 
  * @details
  * This function will only do calculation if the simulation rules requires
- * the philosopher to eat at least how many meal.
+ * the philosopher to eat at least how many meal. It is called by the philo
+ * itself right after a meal, so the simulation ends as soon as the last
+ * philo gets full instead of waiting for the monitor to notice.
  * The function checks if the assigned philosopher has eaten what's required.
  * If yes and the assigned philo has not "declared" as full yet, increment
  * philo_full, which is use to keep track how many philosopher is full.
@@ -34,88 +36,120 @@
 int	pl_full_tracker(t_philo *philo)
 {
 	int	iteration;
+	int	all_full;
 
 	iteration = philo->rules->iteration;
 	if (iteration == 0)
 		return (0);
-	pthread_mutex_lock(&philo->rules->locks.full_lock);
+	pl_mutex_lock(&philo->rules->locks.full_lock);
 	if (pl_get_meal_count(philo) >= iteration && philo->full == NOTFULL)
 	{
 		philo->rules->philo_full++;
 		philo->full = FULL;
 	}
-	if (philo->rules->philo_full == philo->rules->philo_total)
+	all_full = (philo->rules->philo_full == philo->rules->philo_total);
+	pl_mutex_unlock(&philo->rules->locks.full_lock);
+	if (all_full)
 	{
-		pl_fork_action(philo, RETURN);
-		pthread_mutex_lock(&philo->rules->locks.sim_state_lock);
-		philo->rules->sim_state = END;
-		pthread_mutex_unlock(&philo->rules->locks.sim_state_lock);
-		pthread_mutex_unlock(&philo->rules->locks.full_lock);
-		return (1);
+		pl_log_halt(&philo->rules->log, philo->id, FULL);
+		pl_end_simulation_state(philo->rules);
 	}
-	pthread_mutex_unlock(&philo->rules->locks.full_lock);
-	return (0);
+	return (all_full);
 }
 
 /**
- * @brief Check if a philo will die of starvation or not
- * @param philo The assigned philo
+ * @brief Check if the philo closest to starvation is dead
+ * @param sim The simulation struct
  * 
  * @details
- * This function checks if assigned philo will die of starvation or not.
- * This is done by comparing the philo's last ate time and the time to die.
- * When the compared value is greater and equal than the time to die,
- * set the simulation state to "END". Declare the assign philo as dead.
+ * The root of the deadline heap holds the philo with the smallest known
+ * deadline (last ate time + time to die). The key stored in the heap is
+ * only a lower bound: the philo might have eaten since it was pushed. So
+ * first refresh the root until its key is the real deadline, then compare
+ * it with the current time. Since every other key is a lower bound as
+ * well, nobody else can starve before the root does.
  * 
  * @return
- * 1, if the assigned philo died because of starvation.
- * 0, if the assigned philo did not died.
+ * -1, if the philo at the root died of starvation.
+ * Otherwise, the time at which the root could die next.
 */
-int	pl_check_dead(t_philo *philo)
+static t_tick	pl_check_dead(t_simulation *sim)
 {
-	time_t	curr_time;
-	time_t	last_ate;
+	t_heap_node	*root;
+	t_philo		*philo;
+	t_tick		deadline;
 
-	pthread_mutex_lock(&philo->rules->locks.death_lock);
-	last_ate = pl_get_last_ate(philo);
-	curr_time = pl_get_time();
-	if ((curr_time - last_ate) > philo->rules->time_to_die)
+	root = &sim->deadlines.nodes[0];
+	philo = &sim->philos[root->val];
+	deadline = pl_get_last_ate(philo) + sim->rules->time_to_die * TICK_MS;
+	while (deadline > root->key)
 	{
+		pl_heap_update_root(&sim->deadlines, deadline);
+		philo = &sim->philos[root->val];
+		deadline = pl_get_last_ate(philo) + sim->rules->time_to_die * TICK_MS;
+	}
+	if (pl_now() > deadline)
+	{
+		pl_trace_mark(sim->rules, &sim->watch, SPAN_DIED, philo->id);
 		pl_declare_state(philo, DIED);
-		pl_fork_action(philo, RETURN);
-		pthread_mutex_lock(&philo->rules->locks.sim_state_lock);
-		philo->rules->sim_state = END;
-		pthread_mutex_unlock(&philo->rules->locks.sim_state_lock);
-		pthread_mutex_unlock(&philo->rules->locks.death_lock);
-		return (1);
+		pl_end_simulation_state(sim->rules);
+		return (-1);
 	}
-	pthread_mutex_unlock(&philo->rules->locks.death_lock);
-	return (0);
+	return (deadline + 1);
 }
 
 /**
  * @brief Routine for monitor thread
- * @param arg The philo struct
+ * @param arg The simulation struct
  * 
  * @details
- * The idea of this routine is to check if the philosopher will die because
- * of starvation. As well as if all the philo are full or not.
+ * There's only one monitor for the whole table. It sleeps until the next
+ * philo could possibly starve, checks that philo and goes back to sleep.
+ * The nap ends early when the simulation ends for another reason
+ * (everyone is full). Checks and naps are spans of its timeline
+ * (--trace).
  * 
  * Same as philosophers' routine, when the simulation state is END, end the
  * routine.
 */
 void	*pl_monitor(void *arg)
 {
-	t_philo	*philo;
+	t_simulation	*sim;
+	t_tick			until;
 
-	philo = arg;
-	while (1)
+	sim = arg;
+	while (pl_get_sim_state(sim->philos) != END)
 	{
-		if (pl_get_sim_state(philo) == END)
-			break ;
-		if (pl_check_dead(philo) == 1 || pl_full_tracker(philo) == 1)
+		pl_trace_mark(sim->rules, &sim->watch, SPAN_CHECK, -1);
+		until = pl_check_dead(sim);
+		if (until == -1)
 			break ;
-		usleep(philo->rules->time_to_die * 1000 / 2);
+		pl_trace_mark(sim->rules, &sim->watch, SPAN_NAP, -1);
+		pl_nap(sim->rules, until, 0);
 	}
 	return (NULL);
 }
+
+/**
+ * @brief Fill the deadline heap and start the monitor thread
+ * @param sim The simulation struct, the heap's nodes in its arena
+ * 
+ * @return 1 if the monitor is running. 0 if there's an error.
+*/
+int	pl_spawn_monitor(t_simulation *sim)
+{
+	int		i;
+	t_philo	*pl;
+
+	i = -1;
+	pl = sim->philos;
+	while (++i < sim->rules->philo_total)
+		pl_heap_push(&sim->deadlines,
+			pl_get_last_ate(&pl[i]) + sim->rules->time_to_die * TICK_MS, i);
+	if (pthread_create(&sim->monitor, NULL, &pl_monitor, (void *)sim) != 0)
+		return (pl_show_error(CREATE_THD_FAILED, -1));
+	pl_rt_pin(sim->rules, sim->monitor, sim->rules->philo_total,
+		sim->rules->philo_total + 1);
+	pl_rt_boost(sim->rules, sim->monitor);
+	return (1);
+}
@@ -6,12 +6,36 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/13 10:13:17 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/02/22 11:12:45 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 22:30:14 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
+/**
+ * @brief Show the message of an error in the arguments or the options
+ * @param error Error type
+ * @param id The engine, for ENGINE_FLAG
+*/
+static void	pl_show_usage_error(t_error error, int id)
+{
+	if (error == INVALID_ARGS_TOTAL)
+		printf("Require at least 4 or 5 arguments!\n\n");
+	else if (error == NON_NUMERIC_ARGS)
+		printf("Found non numeric arguments!\n\n");
+	else if (error == NEGATIVE_ARGS)
+		printf("Found Negative numeric argument!\n\n");
+	else if (error == INVALID_OPTION)
+		printf("Optional argument should more than 0!\n\n");
+	else if (error == INVALID_FLAG)
+		printf("Unknown option, or its value is invalid!\n\n");
+	else if (error == ENGINE_FLAG && id == DES)
+		printf("--engine=des only runs --fork=naive and --sched=stagger, "
+			"and keeps no --trace!\n\n");
+	else if (error == ENGINE_FLAG)
+		printf("--engine=coro only runs --fork=naive!\n\n");
+}
+
 /**
  * @brief Show error message
  * @param error Error type
@@ -23,6 +47,9 @@
  * 3. NEGATIVE_ARGS - Found negative arguments.
  * 4. CREATE_THD_FAILED - Failed to create thread.
  * 5. CREATE_MUT_FAILED - Failed to create mutex.
+ * 6. ARENA_FAILED - Failed to map the arena, the table is too big.
+ * 7. ENGINE_FLAG - An option the engine doesn't run (id is the engine).
+ * 8. ENGINE_FAILED - Failed to allocate the engine (id is the table size).
  * 
  * @return
  * 1, if the error type is unknown
@@ -33,20 +60,18 @@ int	pl_show_error(t_error error, int id)
 	if (error < 0 || error >= ERROR_TOTAL)
 		return (1);
 	printf(RED"[ERROR]: ");
-	if (error == INVALID_ARGS_TOTAL)
-		printf("Require at least 4 or 5 arguments!\n\n");
-	else if (error == NON_NUMERIC_ARGS)
-		printf("Found non numeric arguments!\n\n");
-	else if (error == NEGATIVE_ARGS)
-		printf("Found Negative numeric argument!\n\n");
-	else if (error == INVALID_OPTION)
-		printf("Optional argument should more than 0!\n\n");
+	if (error < CREATE_THD_FAILED)
+		pl_show_usage_error(error, id);
 	else if (error == CREATE_THD_FAILED)
 		printf("Failed to create PHILO %d\n", id);
 	else if (error == CREATE_MUT_FAILED)
 		printf("Failed to create MUTEX %d\n", id);
 	else if (error == DESTROY_MUT_FAILED)
 		printf("Failed to destroy MUTEX %d\n", id);
+	else if (error == ARENA_FAILED)
+		printf("Failed to map the ARENA for %d seats\n", id);
+	else if (error == ENGINE_FAILED)
+		printf("Failed to allocate the ENGINE for %d seats\n", id);
 	if (!(error >= CREATE_THD_FAILED && error < ERROR_TOTAL))
 		printf(GRN"Run `make help` for help.\n"DEF);
 	return (0);
@@ -56,27 +81,23 @@ int	pl_show_error(t_error error, int id)
  * @brief Declare the state of a philo
  * @param philo The target philo
  * @param state The state of the philo
+ * 
+ * @details
+ * Nothing is printed here: the event goes into the philo's own ring and
+ * the log writer prints it. A death halts the log, so it's the last line.
+ * A philo's own state changes are marks on his timeline too (--trace).
 */
 void	pl_declare_state(t_philo *philo, t_state state)
 {
-	time_t	curr_time;
-	time_t	start_time;
+	static const t_span	spans[] = {SPAN_FORK, SPAN_EAT, SPAN_SLEEP,
+		SPAN_THINK};
 
-	if (philo == NULL || pl_get_sim_state(philo) == END)
+	if (philo == NULL)
 		return ;
-	pthread_mutex_lock(&philo->rules->locks.declare_lock);
-	curr_time = pl_get_time();
-	start_time = philo->rules->start_time;
-	printf("%8ld %3d ", curr_time - start_time, philo->id + 1);
-	if (state == FORK)
-		printf(PUR"has taken a fork\n"DEF);
-	else if (state == EAT)
-		printf(GRN"is eating\n"DEF);
-	else if (state == SLEEP)
-		printf(CYN"is sleeping\n"DEF);
-	else if (state == THINK)
-		printf(YLW"is thinking\n"DEF);
-	else if (state == DIED)
-		printf(RED"%s\n"DEF, "died");
-	pthread_mutex_unlock(&philo->rules->locks.declare_lock);
+	if (state <= THINK)
+		pl_trace_mark(philo->rules, &philo->trace, spans[state], -1);
+	if (state == DIED)
+		pl_log_halt(&philo->rules->log, philo->id, DIED);
+	else
+		pl_log_push(&philo->rules->log, philo->id, state);
 }
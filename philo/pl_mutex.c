@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_mutex.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:06:12 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/18 00:06:12 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#if PL_LOCKSTAT == 0
+
+/**
+ * @brief Lock a mutex
+ * @param mutex The mutex
+*/
+void	pl_mutex_lock(t_mutex *mutex)
+{
+	pthread_mutex_lock(mutex);
+}
+
+/**
+ * @brief Lock a mutex if it's free
+ * @param mutex The mutex
+ * 
+ * @return 0 if it's now locked, an error number (EBUSY) if not.
+*/
+int	pl_mutex_trylock(t_mutex *mutex)
+{
+	return (pthread_mutex_trylock(mutex));
+}
+
+/**
+ * @brief Unlock a mutex
+ * @param mutex The mutex
+*/
+void	pl_mutex_unlock(t_mutex *mutex)
+{
+	pthread_mutex_unlock(mutex);
+}
+
+/**
+ * @brief Wait on a condition variable
+ * @param cond The condition variable
+ * @param mutex The mutex guarding it, locked
+*/
+void	pl_cond_wait(pthread_cond_t *cond, t_mutex *mutex)
+{
+	pthread_cond_wait(cond, mutex);
+}
+
+/**
+ * @brief Tear a mutex down
+ * @param mutex The mutex, unlocked
+ * @param lockstat Unused, the stats are only kept with LOCKSTAT=1
+ * @param cls Unused
+ * @param id Unused
+*/
+void	pl_mutex_destroy(t_mutex *mutex, t_lockstat *lockstat,
+		t_lock_class cls, int id)
+{
+	(void)lockstat;
+	(void)cls;
+	(void)id;
+	pthread_mutex_destroy(mutex);
+}
+
+#endif
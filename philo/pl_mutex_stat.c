@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_mutex_stat.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:06:12 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/18 00:06:12 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#if PL_LOCKSTAT
+
+/**
+ * @brief Lock a mutex, counting it
+ * @param mutex The mutex
+ * 
+ * @details
+ * A trylock first tells a free mutex from one that has to be waited for.
+ * Only then is the clock read for the wait, an uncontended lock costs a
+ * single clock read, for the start of the hold. The stats are updated
+ * with the mutex held, nobody else writes them meanwhile.
+*/
+void	pl_mutex_lock(t_mutex *mutex)
+{
+	t_tick	start;
+	t_tick	wait;
+
+	if (pthread_mutex_trylock(&mutex->mutex) == 0)
+		mutex->since = pl_now();
+	else
+	{
+		start = pl_now();
+		pthread_mutex_lock(&mutex->mutex);
+		mutex->since = pl_now();
+		wait = mutex->since - start;
+		mutex->stats.contended++;
+		mutex->stats.wait_total += wait;
+		if (wait > mutex->stats.wait_max)
+			mutex->stats.wait_max = wait;
+	}
+	mutex->stats.acquired++;
+}
+
+/**
+ * @brief Lock a mutex if it's free, counting it if it is
+ * @param mutex The mutex
+ * 
+ * @details
+ * A failed try isn't counted: the stats belong to the holder.
+ * 
+ * @return 0 if it's now locked, an error number (EBUSY) if not.
+*/
+int	pl_mutex_trylock(t_mutex *mutex)
+{
+	int	err;
+
+	err = pthread_mutex_trylock(&mutex->mutex);
+	if (err != 0)
+		return (err);
+	mutex->since = pl_now();
+	mutex->stats.acquired++;
+	return (0);
+}
+
+/**
+ * @brief Unlock a mutex, counting how long it was held
+ * @param mutex The mutex
+*/
+void	pl_mutex_unlock(t_mutex *mutex)
+{
+	t_tick	hold;
+
+	hold = pl_now() - mutex->since;
+	mutex->stats.hold_total += hold;
+	if (hold > mutex->stats.hold_max)
+		mutex->stats.hold_max = hold;
+	pthread_mutex_unlock(&mutex->mutex);
+}
+
+/**
+ * @brief Wait on a condition variable
+ * @param cond The condition variable
+ * @param mutex The mutex guarding it, locked
+ * 
+ * @details
+ * The mutex is let go while waiting: the hold stops there, and starts
+ * over once it's taken back. Taking it back isn't counted as an
+ * acquisition, the wait is for the condition, not for the mutex.
+*/
+void	pl_cond_wait(pthread_cond_t *cond, t_mutex *mutex)
+{
+	t_tick	hold;
+
+	hold = pl_now() - mutex->since;
+	mutex->stats.hold_total += hold;
+	if (hold > mutex->stats.hold_max)
+		mutex->stats.hold_max = hold;
+	pthread_cond_wait(cond, &mutex->mutex);
+	mutex->since = pl_now();
+}
+
+/**
+ * @brief Tear a mutex down, adding its stats to the report
+ * @param mutex The mutex, unlocked
+ * @param lockstat The stats of the mutexes torn down so far
+ * @param cls What it guarded
+ * @param id Which one it was
+*/
+void	pl_mutex_destroy(t_mutex *mutex, t_lockstat *lockstat,
+		t_lock_class cls, int id)
+{
+	pl_lockstat_add(lockstat, cls, id, &mutex->stats);
+	pthread_mutex_destroy(&mutex->mutex);
+}
+
+#endif
@@ -0,0 +1,155 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_option.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:17:17 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Match an option against its name
+ * @param arg The argument, e.g. "--spin=50"
+ * @param name The option's name, e.g. "--spin"
+ * 
+ * @return The value after "<name>=", NULL if arg is not that option.
+*/
+char	*pl_opt_value(char *arg, char *name)
+{
+	while (*name != '\0' && *arg == *name)
+	{
+		arg++;
+		name++;
+	}
+	if (*name != '\0' || *arg != '=')
+		return (NULL);
+	return (arg + 1);
+}
+
+/**
+ * @brief Read the unsigned number of an option
+ * @param value The value of the option
+ * @param max The biggest value allowed
+ * @param num Where to store the number
+ * 
+ * @return 1 on success, 0 if value is not a number or is bigger than max.
+*/
+static int	pl_opt_number(char *value, long max, long *num)
+{
+	*num = 0;
+	if (*value == '\0')
+		return (0);
+	while (*value >= '0' && *value <= '9')
+	{
+		*num = *num * 10 + (*value++ - '0');
+		if (*num > max)
+			return (0);
+	}
+	return (*value == '\0');
+}
+
+/**
+ * @brief Parse an option that takes no value
+ * @param arg The argument
+ * @param opts The options struct
+ * 
+ * @return 1 if arg is one of them, 0 otherwise.
+*/
+static int	pl_parse_switch(char *arg, t_options *opts)
+{
+	if (strcmp(arg, "--report") == 0)
+		opts->report = 1;
+	else if (strcmp(arg, "--hugepages") == 0)
+		opts->huge = 1;
+	else if (strcmp(arg, "--empty") == 0)
+		opts->empty = 1;
+	else
+		return (0);
+	return (1);
+}
+
+/**
+ * @brief Parse a single option
+ * @param arg The argument
+ * @param opts The options struct
+ * 
+ * @return 1 if the option is known and its value valid, 0 otherwise.
+*/
+static int	pl_parse_option(char *arg, t_options *opts)
+{
+	char	*value;
+	long	num;
+	int		ret;
+
+	if (pl_parse_switch(arg, opts))
+		return (1);
+	ret = pl_parse_rt(arg, opts);
+	if (ret != -1)
+		return (ret);
+	value = pl_opt_value(arg, "--spin");
+	if (value != NULL)
+	{
+		if (pl_opt_number(value, 1000000, &num) == 0)
+			return (0);
+		opts->spin = num * TICK_US;
+		return (1);
+	}
+	value = pl_opt_value(arg, "--trace");
+	if (value != NULL)
+	{
+		opts->trace = value;
+		return (*value != '\0');
+	}
+	return (pl_parse_choice(arg, opts));
+}
+
+/**
+ * @brief Parse the options that come after the arguments
+ * @param ac Option count
+ * @param av Options
+ * @param opts The options struct
+ * 
+ * @details
+ * Options look like `--name=value`, or just `--name` for switches.
+ * Anything not given keeps its default:
+ * --spin=0			Sleep all the way to a wake up, no yielding
+ * --fork=naive		Left fork then right fork, odd philos start late
+ * --format=text	Aligned columns with colours
+ * --report			Off
+ * --engine=threads	A thread per philo, on the wall clock
+ * --sched=stagger	Odd philos start late, then eat when they can
+ * --affinity=none	Threads go where the scheduler puts them
+ * --rt, --mlock	Off: normal scheduling, pages may be swapped out
+ * --hugepages		Off: the arena gets small pages
+ * --empty			Off: the philos sit down once the table is set
+ * --trace=<file>	Off: no timelines are kept
+ * 
+ * @return Return 1 if every option is valid, 0 otherwise.
+*/
+int	pl_parse_options(int ac, char **av, t_options *opts)
+{
+	opts->spin = 0;
+	opts->fork = pl_fork_strategy("naive");
+	opts->report = 0;
+	opts->format = TEXT;
+	opts->engine = THREADS;
+	opts->sched = STAGGER;
+	opts->pin = PIN_NONE;
+	opts->rt_policy = SCHED_OTHER;
+	opts->rt_prio = 0;
+	opts->mlock = 0;
+	opts->huge = 0;
+	opts->empty = 0;
+	opts->trace = NULL;
+	while (ac-- > 0)
+	{
+		if (pl_parse_option(*av++, opts) == 0)
+			return (pl_show_error(INVALID_FLAG, 0));
+	}
+	return (1);
+}
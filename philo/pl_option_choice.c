@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_option_choice.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:29:57 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Find a value among the ones an option accepts
+ * @param value The value given
+ * @param choices The accepted values, separated by spaces
+ * 
+ * @return Its index among the choices, -1 if it's not one of them.
+*/
+static int	pl_opt_choice(char *value, char *choices)
+{
+	int	index;
+	int	len;
+
+	index = 0;
+	while (*choices != '\0')
+	{
+		len = 0;
+		while (choices[len] != '\0' && choices[len] != ' ')
+			len++;
+		if (strncmp(value, choices, len) == 0 && value[len] == '\0')
+			return (index);
+		choices += len;
+		if (*choices == ' ')
+			choices++;
+		index++;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Parse an option that takes one of a few names, if it's that one
+ * @param arg The argument
+ * @param name The option's name
+ * @param choices The accepted values, separated by spaces
+ * @param out Where to store the index of the value
+ * 
+ * @return -1 if arg is not that option, 1 if its value is valid, 0 if not.
+*/
+static int	pl_opt_enum(char *arg, char *name, char *choices, int *out)
+{
+	char	*value;
+
+	value = pl_opt_value(arg, name);
+	if (value == NULL)
+		return (-1);
+	*out = pl_opt_choice(value, choices);
+	return (*out >= 0);
+}
+
+/**
+ * @brief Parse an option that takes one of a few names
+ * @param arg The argument
+ * @param opts The options struct
+ * 
+ * @return 1 if the option is known and its value valid, 0 otherwise.
+*/
+int	pl_parse_choice(char *arg, t_options *opts)
+{
+	char	*value;
+	int		ret;
+	int		choice;
+
+	value = pl_opt_value(arg, "--fork");
+	if (value != NULL)
+	{
+		opts->fork = pl_fork_strategy(value);
+		return (opts->fork != NULL);
+	}
+	ret = pl_opt_enum(arg, "--format", "text plain csv bin", &choice);
+	if (ret == 1)
+		opts->format = choice;
+	if (ret != -1)
+		return (ret);
+	ret = pl_opt_enum(arg, "--engine", "threads des coro", &choice);
+	if (ret == 1)
+		opts->engine = choice;
+	if (ret != -1)
+		return (ret);
+	ret = pl_opt_enum(arg, "--sched", "stagger adaptive", &choice);
+	if (ret == 1)
+		opts->sched = choice;
+	return (ret == 1);
+}
+
+/**
+ * @brief Read a real-time policy and its priority
+ * @param value "fifo" or "rr", then maybe ":<prio>"
+ * @param opts The options struct
+ * 
+ * @return 1 if the priority is between 1 and 99 (RT_PRIO if none),
+ *         0 otherwise.
+*/
+static int	pl_opt_policy(char *value, t_options *opts)
+{
+	opts->rt_prio = RT_PRIO;
+	opts->rt_policy = SCHED_RR;
+	if (strncmp(value, "fifo", 4) == 0)
+		opts->rt_policy = SCHED_FIFO;
+	if (opts->rt_policy == SCHED_FIFO)
+		value += 4;
+	else if (strncmp(value, "rr", 2) == 0)
+		value += 2;
+	else
+		return (0);
+	if (*value == '\0')
+		return (1);
+	if (*value++ != ':' || *value == '\0')
+		return (0);
+	opts->rt_prio = 0;
+	while (*value >= '0' && *value <= '9' && opts->rt_prio < 100)
+		opts->rt_prio = opts->rt_prio * 10 + (*value++ - '0');
+	return (*value == '\0' && opts->rt_prio >= 1 && opts->rt_prio <= 99);
+}
+
+/**
+ * @brief Parse the options that place the threads on the CPUs
+ * @param arg The argument
+ * @param opts The options struct
+ * 
+ * @details
+ * --affinity=none|rr|numa	Pin every thread to a CPU, see pl_rt_pin
+ * --rt=fifo|rr[:<prio>]	SCHED_FIFO or SCHED_RR, the monitor one above
+ * --mlock					Lock every page, now and to come, in memory
+ * 
+ * @return -1 if arg is not one of them, 1 if its value is valid, 0 if not.
+*/
+int	pl_parse_rt(char *arg, t_options *opts)
+{
+	char	*value;
+	int		ret;
+	int		choice;
+
+	if (strcmp(arg, "--mlock") == 0)
+	{
+		opts->mlock = 1;
+		return (1);
+	}
+	ret = pl_opt_enum(arg, "--affinity", "none rr numa", &choice);
+	if (ret == 1)
+		opts->pin = choice;
+	if (ret != -1)
+		return (ret);
+	value = pl_opt_value(arg, "--rt");
+	if (value == NULL)
+		return (-1);
+	return (pl_opt_policy(value, opts));
+}
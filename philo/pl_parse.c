@@ -6,7 +6,7 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/13 10:45:21 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/02/22 14:23:00 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 23:11:51 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -21,35 +21,25 @@
  * @details
  * 1. Last ate lock - Philo's last ate time. (PHILO)
  * 2. Meal count lock - Philo's meal count. (PHILO)
- * 3. Declare lock - Philo's state declaration. (SHARED)
- * 4. Sim state lock - Simulation's state. (SHARED)
- * 5. Death lock - Check if dead process lock. (SHARED)
- * 6. Full lock - Check if full process lock. (SHARED)
+ * 3. Full lock - Check if full process lock. (SHARED)
+ * They're default mutexes, set up from the static initialiser (see
+ * pl_mutex_init). They're destroyed in pl_arena_free.
  * 
  * @return
  * 1, If all additional locks can be initialized.
- * 0, If there's an error while creating a mutex.
+ * 0, If the lock type is unknown.
 */
 int	pl_lock_setup(t_locks *locks, t_philo *philo, t_lock_type type)
 {
-	if (type != SHARED && type != PHILO)
-		return (0);
 	if (type == SHARED)
+		pl_mutex_init(&locks->full_lock);
+	else if (type == PHILO)
 	{
-		if (pthread_mutex_init(&locks->declare_lock, NULL) != 0)
-			return (pl_show_error(CREATE_MUT_FAILED, -1));
-		if (pthread_mutex_init(&locks->sim_state_lock, NULL) != 0)
-			return (pl_show_error(CREATE_MUT_FAILED, -1));
-		if (pthread_mutex_init(&locks->death_lock, NULL) != 0)
-			return (pl_show_error(CREATE_MUT_FAILED, -1));
-		if (pthread_mutex_init(&locks->full_lock, NULL) != 0)
-			return (pl_show_error(CREATE_MUT_FAILED, -1));
-		return (1);
+		pl_mutex_init(&philo->last_ate_lock);
+		pl_mutex_init(&philo->meal_count_lock);
 	}
-	if (pthread_mutex_init(&philo->last_ate_lock, NULL) != 0)
-		return (pl_show_error(CREATE_MUT_FAILED, -1));
-	if (pthread_mutex_init(&philo->meal_count_lock, NULL) != 0)
-		return (pl_show_error(CREATE_MUT_FAILED, -1));
+	else
+		return (0);
 	return (1);
 }
 
@@ -95,7 +85,8 @@ static int	pl_check_args(int ac, char **av)
 */
 static void	pl_setup_rules(int ac, char **av, t_rules *rules)
 {
-	rules->sim_state = RUN;
+	atomic_init(&rules->sim_state, RUN);
+	atomic_init(&rules->start_line, 0);
 	rules->philo_total = ft_atoi(*av++);
 	rules->time_to_die = ft_atoi(*av++);
 	rules->time_to_eat = ft_atoi(*av++);
@@ -105,8 +96,30 @@ static void	pl_setup_rules(int ac, char **av, t_rules *rules)
 	else
 		rules->iteration = 0;
 	rules->philo_full = 0;
-	if (pl_lock_setup(&rules->locks, NULL, SHARED) == 0)
-		return ;
+	pl_lock_setup(&rules->locks, NULL, SHARED);
+}
+
+/**
+ * @brief Check that the engine runs every option given
+ * @param opts The options struct
+ * 
+ * @details
+ * The discrete event engine always takes the forks left then right with
+ * odd philos half a meal late ("naive", --sched=stagger), and keeps no
+ * timeline. Coroutines take them left then right too, in either
+ * schedule. Anything else would be silently ignored.
+ * 
+ * @return 1 if it does, 0 otherwise.
+*/
+static int	pl_check_engine(t_options *opts)
+{
+	if (opts->engine == THREADS)
+		return (1);
+	if (strcmp(opts->fork->name, "naive") != 0
+		|| (opts->engine == DES
+			&& (opts->sched != STAGGER || opts->trace != NULL)))
+		return (pl_show_error(ENGINE_FLAG, opts->engine));
+	return (1);
 }
 
 /**
@@ -116,19 +129,28 @@ static void	pl_setup_rules(int ac, char **av, t_rules *rules)
  * @param rules The rules struct
  * 
  * @details
- * 1. Initialize the rules struct
- * 2. If the ac is not 4 nor 5, show error and return
+ * 1. Count the arguments, options (`--name=value`) come after them
+ * 2. If there are not 4 nor 5 arguments, show error and return
  * 3. Check args
- * 4. Set simulation info
+ * 4. Parse the options, and check that the engine runs them
+ * 5. Set simulation info
  * 
  * @return Return 1 if the parse process is successful, 0 otherwise.
 */
 int	pl_parse(int ac, char **av, t_rules *rules)
 {
-	if (ac != 4 && ac != 5)
+	int	argc;
+
+	argc = 0;
+	while (argc < ac && (av[argc][0] != '-' || av[argc][1] != '-'))
+		argc++;
+	if (argc != 4 && argc != 5)
 		return (pl_show_error(INVALID_ARGS_TOTAL, 0));
-	if (pl_check_args(ac, av) == 0)
+	if (pl_check_args(argc, av) == 0)
+		return (0);
+	if (pl_parse_options(ac - argc, av + argc, &rules->opts) == 0
+		|| pl_check_engine(&rules->opts) == 0)
 		return (0);
-	pl_setup_rules(ac, av, rules);
+	pl_setup_rules(argc, av, rules);
 	return (1);
 }
@@ -6,7 +6,7 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/13 14:23:17 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/02/22 11:39:59 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 23:18:04 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -22,78 +22,75 @@
  * 
  * @details
  * The forks will be assigned in this way:
- * 1. Left fork: Own index's fork (mutex)
- * 2. Right fork: Own index's -1 fork (mutex). If the id is 0, meaning that
+ * 1. Left fork: Own index's fork
+ * 2. Right fork: Own index's -1 fork. If the id is 0, meaning that
  *    philo should grab the fork at [total philo - 1].
  * The idea is to let the philo know that when they need to eat, they have
  * to use the fork assigned to them. Of course, need to check if the fork
  * is taken or not.
+ * The philo comes zeroed from the arena, only what isn't 0 is set.
 */
-int	pl_philo_init(t_simulation *sim, t_philo *philo, int id)
+void	pl_philo_init(t_simulation *sim, t_philo *philo, int id)
 {
 	philo->id = id;
-	philo->meal_count = 0;
 	philo->full = NOTFULL;
-	philo->last_ate = pl_get_time();
 	philo->left_fork = &sim->forks[id];
 	philo->rules = sim->rules;
-	if (pl_lock_setup(NULL, philo, PHILO) == 0)
-		return (0);
+	pl_lock_setup(NULL, philo, PHILO);
 	if (id == 0)
 		philo->right_fork = &sim->forks[sim->rules->philo_total - 1];
 	else
 		philo->right_fork = &sim->forks[id - 1];
-	return (1);
 }
 
 /**
- * @brief Preparing forks for philosophers
+ * @brief Prepare a fork for the philosophers
  * @param sim The simulation struct
+ * @param id The fork's index
  * 
- * @return 1 if mutexes can be initialized without error. 0 if one of the mutex
- *         cannot be initialized.
+ * @details
+ * Every fork starts dirty, owned by the lower id of the two philos
+ * sharing it (only the "chandy" strategy looks at this). Its mutex and
+ * condition variable are copied from the static initialisers, the rest
+ * comes zeroed from the arena.
  */
-int	pl_prepare_forks(t_simulation *sim)
+void	pl_fork_init(t_simulation *sim, int id)
 {
-	int				i;
-	pthread_mutex_t	*forks;
+	static const pthread_cond_t	idle = PTHREAD_COND_INITIALIZER;
+	t_fork						*fork;
 
-	i = -1;
-	forks = sim->forks;
-	while (++i < sim->rules->philo_total)
-	{
-		if (pthread_mutex_init(&forks[i], NULL) != 0)
-			return (pl_show_error(CREATE_MUT_FAILED, i));
-	}
-	return (1);
+	fork = &sim->forks[id];
+	pl_mutex_init(&fork->lock);
+	fork->cond = idle;
+	fork->owner = id;
+	if (id == sim->rules->philo_total - 1)
+		fork->owner = 0;
+	fork->dirty = 1;
 }
 
 /**
- * @brief Spawn philo. Create thread for each philo. Spawn one monitor to
- * 	      each philo as well. The monitor thread will be detached, run in
- *        background.
+ * @brief Spawn philo. Create thread for each philo, each waits at the
+ *        start line. The philos are watched by a single monitor thread,
+ *        spawned once the start line opens.
  * @param sim The simulation struct
  * 
- * @return 1 if all the philo can be initialized and thread has started.
- *         0 if there's an issue when creating a thread.
+ * @return 1 if all the philo threads have started.
+ *         0 if there's an issue when creating a thread, the ones already
+ *         running (spawned) go home at the start line.
 */
 int	pl_spawn_philo(t_simulation *sim)
 {
-	int			i;
 	t_philo		*pl;
-	pthread_t	monitor;
 
-	i = -1;
 	pl = sim->philos;
-	while (++i < sim->rules->philo_total)
+	while (sim->spawned < sim->rules->philo_total)
 	{
-		if (pl_philo_init(sim, &pl[i], i) == 0)
-			return (0);
-		if (pthread_create(&pl[i].me, NULL, &pl_routine, (void *)&pl[i]) != 0)
-			return (pl_show_error(CREATE_THD_FAILED, i));
-		if (pthread_create(&monitor, NULL, &pl_monitor, (void *)&pl[i]) != 0)
-			return (pl_show_error(CREATE_THD_FAILED, i));
-		pthread_detach(monitor);
+		if (pthread_create(&pl[sim->spawned].me, NULL, &pl_routine,
+				(void *)&pl[sim->spawned]) != 0)
+			return (pl_show_error(CREATE_THD_FAILED, sim->spawned));
+		pl_rt_pin(sim->rules, pl[sim->spawned].me, sim->spawned,
+			sim->rules->philo_total);
+		sim->spawned++;
 	}
 	return (1);
 }
@@ -103,29 +100,43 @@ int	pl_spawn_philo(t_simulation *sim)
  * @param sim The simulation struct
  * @param rules The rules struct
  * 
- * 1. Get the simulation start time. Will use this to get timestamp of
+ * 1. Map the arena and set up every fork and philo in it, then the fork
+ *    strategy's own state (the set up time, for --report)
+ * 2. Stop there with --empty
+ * 3. Get the simulation start time. Will use this to get timestamp of
  * 	  philo's activity.
- * 2. If the "iteration" option is enabled. Use this to check how
- *    many philo is full.
- * 3. Set rules
- * 4. Prepare forks for philosophers
- * 5. Spawn the philosophers
+ * 4. Start the logger
+ * 5. Spawn the philosophers, threads or coroutines (--engine), they wait
+ *    at the start line. If some can't be spawned, the simulation ends
+ *    before it begins.
+ * 6. Take the start time again, spawn the monitor and let everyone go
 */
 int	pl_simulation_init(t_simulation *sim, t_rules *rules)
 {
+	t_tick	start;
+	int		ok;
+
+	memset(sim, 0, sizeof(t_simulation));
 	sim->rules = rules;
-	sim->forks = malloc(sizeof(pthread_mutex_t) * rules->philo_total);
-	if (sim->forks == NULL)
-		return (0);
-	sim->philos = malloc(sizeof(t_philo) * rules->philo_total);
-	if (sim->philos == NULL)
+	start = pl_now();
+	if (pl_arena_init(sim) == 0)
 		return (0);
-	if (pl_prepare_forks(sim) == 0)
+	pl_arena_fill(sim);
+	if (rules->opts.fork->init != NULL && rules->opts.fork->init(sim) == 0)
 		return (0);
-	rules->start_time = pl_get_time();
-	if (pl_spawn_philo(sim) == 0)
+	sim->arena.setup = pl_now() - start;
+	if (rules->opts.empty)
+		return (1);
+	rules->start_time = pl_now();
+	sim->logged = pl_log_init(&rules->log, rules->philo_total,
+			rules->start_time, rules->opts.format);
+	if (sim->logged == 0)
 		return (0);
-	return (1);
+	ok = (rules->opts.engine == CORO && pl_pool_spawn(sim))
+		|| (rules->opts.engine != CORO && pl_spawn_philo(sim));
+	if (ok == 0)
+		pl_end_simulation_state(rules);
+	return (pl_start_release(sim) && ok);
 }
 
 /**
@@ -133,8 +144,13 @@ int	pl_simulation_init(t_simulation *sim, t_rules *rules)
  * @param rules The simulation rules
  * 
  * @details
- * 1. Initialize the simulation
- * 2. Destroy forks and philo at the end
+ * 1. Initialize the simulation, and the schedule (--sched)
+ * 2. Wait for the philos (or the workers) and the monitor to finish,
+ *    those that got spawned
+ * 3. Stop the logger, printing whatever is left
+ * 4. Print the report, if asked for (--report), and write the
+ *    timelines (--trace)
+ * 5. Destroy forks and philo at the end, unmapping the arena
 */
 void	pl_begin_simulation(t_rules *rules)
 {
@@ -142,14 +158,25 @@ void	pl_begin_simulation(t_rules *rules)
 	t_simulation	*sim;
 
 	sim = malloc(sizeof(t_simulation));
+	if (sim == NULL)
+		return ;
+	pl_sched_init(rules);
 	pl_simulation_init(sim, rules);
 	i = -1;
-	while (++i < rules->philo_total)
-	{
-		if (pthread_join(sim->philos[i].me, NULL) != 0)
-			break ;
-	}
-	free(sim->forks);
-	free(sim->philos);
+	while (rules->opts.engine != CORO && ++i < sim->spawned)
+		pthread_join(sim->philos[i].me, NULL);
+	if (rules->opts.engine == CORO)
+		pl_pool_join(&sim->pool);
+	if (sim->watched)
+		pthread_join(sim->monitor, NULL);
+	if (sim->logged)
+		pl_log_stop(&rules->log);
+	if (rules->opts.report && sim->logged)
+		pl_report(sim);
+	if (rules->opts.trace != NULL && sim->logged)
+		pl_trace_write(sim);
+	pl_arena_free(sim);
+	if (rules->opts.report)
+		pl_report_arena(sim);
 	free(sim);
 }
@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_philo_state.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:09:15 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:15:22 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#if PL_ATOMIC == 0
+
+/**
+ * @brief Get assigned philo's last ate time
+ * @param philo The assigned philo
+ * 
+ * @details
+ * Last ate is a variable that will be accessed by both monitor and philo.
+ * Philo will update (write) is when he is eating while monitor will use
+ * it to check (read) if a philo to starve to dead. Hence to prevent this
+ * variable being accessed by both monitor and philo (data race), it's
+ * required to lock and unlock this code segment using mutex.
+ * 
+ * @return
+ * Philo's last ate time
+*/
+t_tick	pl_get_last_ate(t_philo *philo)
+{
+	t_tick	last_ate;
+
+	pl_mutex_lock(&philo->last_ate_lock);
+	last_ate = philo->last_ate;
+	pl_mutex_unlock(&philo->last_ate_lock);
+	return (last_ate);
+}
+
+/**
+ * @brief Set assigned philo's last ate time
+ * @param philo The assigned philo
+ * @param time The time the philo started eating
+*/
+void	pl_set_last_ate(t_philo *philo, t_tick time)
+{
+	pl_mutex_lock(&philo->last_ate_lock);
+	philo->last_ate = time;
+	pl_mutex_unlock(&philo->last_ate_lock);
+}
+
+/**
+ * @brief Get philo's meal count
+ * @param philo The assigned philo
+ * 
+ * @details
+ * Meal count will be accessed by both monitor and philo as well. Philo
+ * will update the variable and monitor will read it. A mutex is required
+ * to prevent both of them access the value at the same time.
+ * 
+ * @return
+ * Meal count
+*/
+int	pl_get_meal_count(t_philo *philo)
+{
+	int	meal_count;
+
+	pl_mutex_lock(&philo->meal_count_lock);
+	meal_count = philo->meal_count;
+	pl_mutex_unlock(&philo->meal_count_lock);
+	return (meal_count);
+}
+
+/**
+ * @brief Increment philo's meal count by one
+ * @param philo The assigned philo
+*/
+void	pl_add_meal(t_philo *philo)
+{
+	pl_mutex_lock(&philo->meal_count_lock);
+	philo->meal_count++;
+	pl_mutex_unlock(&philo->meal_count_lock);
+}
+
+#endif
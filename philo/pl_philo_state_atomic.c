@@ -0,0 +1,65 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_philo_state_atomic.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:09:15 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:15:22 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#if PL_ATOMIC
+
+/**
+ * @brief Get assigned philo's last ate time
+ * @param philo The assigned philo
+ * 
+ * @details
+ * Only the philo itself writes last_ate, everyone else only reads it.
+ * A single acquire load pairs with the release store in pl_set_last_ate,
+ * no mutex round-trip is needed.
+ * 
+ * @return
+ * Philo's last ate time
+*/
+t_tick	pl_get_last_ate(t_philo *philo)
+{
+	return (atomic_load_explicit(&philo->last_ate, memory_order_acquire));
+}
+
+/**
+ * @brief Publish assigned philo's last ate time
+ * @param philo The assigned philo
+ * @param time The time the philo started eating
+*/
+void	pl_set_last_ate(t_philo *philo, t_tick time)
+{
+	atomic_store_explicit(&philo->last_ate, time, memory_order_release);
+}
+
+/**
+ * @brief Get philo's meal count
+ * @param philo The assigned philo
+ * 
+ * @return
+ * Meal count
+*/
+int	pl_get_meal_count(t_philo *philo)
+{
+	return (atomic_load_explicit(&philo->meal_count, memory_order_acquire));
+}
+
+/**
+ * @brief Increment philo's meal count by one
+ * @param philo The assigned philo
+*/
+void	pl_add_meal(t_philo *philo)
+{
+	atomic_fetch_add_explicit(&philo->meal_count, 1, memory_order_release);
+}
+
+#endif
@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_pool.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:38:57 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:18:04 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Allocate the workers and the stacks of the coroutines
+ * @param pool The pool
+ * @param total Number of philo
+ * 
+ * @details
+ * One worker per online core, no more than there are philos. The stacks
+ * are a single mapping, so that a hundred thousand philos don't need a
+ * hundred thousand mappings, and with no swap reserved, so that only the
+ * pages a coroutine actually touches are ever backed. There's no guard
+ * page between two stacks. The coroutines themselves are per seat state,
+ * in the simulation's arena.
+ * 
+ * @return 1 on success, 0 on error (and it's shown).
+*/
+static int	pl_pool_alloc(t_pool *pool, int total)
+{
+	int	i;
+
+	pool->worker_total = sysconf(_SC_NPROCESSORS_ONLN);
+	if (pool->worker_total < 1)
+		pool->worker_total = 1;
+	if (pool->worker_total > total)
+		pool->worker_total = total;
+	pool->workers = pl_alloc_lines(pool->worker_total, sizeof(t_worker));
+	if (pool->workers == NULL)
+		return (pl_show_error(ENGINE_FAILED, total));
+	memset(pool->workers, 0, sizeof(t_worker) * pool->worker_total);
+	pool->stacks = mmap(NULL, (size_t)total * CORO_STACK,
+			PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS
+			| MAP_NORESERVE | MAP_STACK, -1, 0);
+	i = -1;
+	while (pool->stacks != MAP_FAILED && ++i < pool->worker_total)
+	{
+		pool->workers[i].id = i;
+		pool->workers[i].pool = pool;
+		if (pl_runq_init(&pool->workers[i].runq, total) == 0
+			|| pl_heap_init(&pool->workers[i].timers, total) == 0)
+			return (pl_show_error(ENGINE_FAILED, total));
+	}
+	return (pool->stacks != MAP_FAILED
+		|| pl_show_error(ENGINE_FAILED, total));
+}
+
+/**
+ * @brief Make the coroutine of a philo, ready to run on a worker
+ * @param pool The pool
+ * @param philo The philo
+ * 
+ * @details
+ * Philos are dealt to the workers in turn. They won't stay put: idle
+ * workers steal, and a philo handed a fork runs where it was put down.
+*/
+static int	pl_coro_init(t_pool *pool, t_philo *philo)
+{
+	t_coro		*coro;
+	uintptr_t	addr;
+
+	coro = &pool->coros[philo->id];
+	coro->philo = philo;
+	coro->worker = &pool->workers[philo->id % pool->worker_total];
+	if (getcontext(&coro->ctx) != 0)
+		return (pl_show_error(ENGINE_FAILED, pool->sim->rules->philo_total));
+	coro->ctx.uc_stack.ss_sp = pool->stacks + (size_t)philo->id * CORO_STACK;
+	coro->ctx.uc_stack.ss_size = CORO_STACK;
+	coro->ctx.uc_link = NULL;
+	addr = (uintptr_t)coro;
+	makecontext(&coro->ctx, (void (*)(void)) & pl_coro_main, 2,
+		(unsigned int)(addr >> 16 >> 16), (unsigned int)addr);
+	pl_runq_push(&coro->worker->runq, philo->id);
+	return (1);
+}
+
+/**
+ * @brief Run the philos as coroutines on a pool of workers
+ *        (--engine=coro), instead of a thread each
+ * @param sim The simulation struct
+ * 
+ * @return 1 if every worker is running. 0 if there's an error.
+*/
+int	pl_pool_spawn(t_simulation *sim)
+{
+	int		i;
+	t_pool	*pool;
+
+	pool = &sim->pool;
+	pool->sim = sim;
+	if (pl_pool_alloc(pool, sim->rules->philo_total) == 0)
+		return (0);
+	i = -1;
+	while (++i < sim->rules->philo_total)
+	{
+		if (pl_coro_init(pool, &sim->philos[i]) == 0)
+			return (0);
+	}
+	i = -1;
+	while (++i < pool->worker_total)
+	{
+		if (pthread_create(&pool->workers[i].me, NULL, &pl_worker,
+				&pool->workers[i]) != 0)
+			return (pl_show_error(CREATE_THD_FAILED, i));
+		pl_rt_pin(sim->rules, pool->workers[i].me, i, pool->worker_total);
+		sim->spawned++;
+	}
+	return (1);
+}
+
+/**
+ * @brief Wait for the workers that got spawned to finish and release
+ *        the pool (the coroutines are the arena's)
+ * @param pool The pool
+*/
+void	pl_pool_join(t_pool *pool)
+{
+	int	i;
+
+	if (pool->workers == NULL)
+		return ;
+	i = -1;
+	while (++i < pool->worker_total)
+	{
+		if (i < pool->sim->spawned)
+			pthread_join(pool->workers[i].me, NULL);
+		free(pool->workers[i].runq.slots);
+		free(pool->workers[i].timers.nodes);
+		pl_mutex_destroy(&pool->workers[i].runq.lock, &pool->sim->lockstat,
+			LOCK_RUNQ, i);
+	}
+	if (pool->stacks != MAP_FAILED)
+		munmap(pool->stacks, (size_t)pool->sim->rules->philo_total
+			* CORO_STACK);
+	free(pool->workers);
+}
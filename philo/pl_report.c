@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_report.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:21:50 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:33:57 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Print the queue stats of the forks ("fifo" strategy only)
+ * @param sim The simulation struct
+ * @param meals Meals eaten in total
+ * 
+ * @details
+ * queue_max is the longest queue any fork had, holder included.
+ * fork_wait is the time every philo spent queued for a fork, added up,
+ * fork_wait/meal the same for an average meal (both forks).
+*/
+static void	pl_report_queues(t_simulation *sim, long meals)
+{
+	int		i;
+	int		queue_max;
+	t_tick	wait_total;
+
+	i = -1;
+	queue_max = 0;
+	wait_total = 0;
+	while (++i < sim->rules->philo_total)
+	{
+		wait_total += sim->forks[i].wait_total;
+		if (sim->forks[i].queue_max > queue_max)
+			queue_max = sim->forks[i].queue_max;
+	}
+	if (queue_max == 0)
+		return ;
+	if (meals == 0)
+		meals = 1;
+	fprintf(stderr, "queue_max=%d fork_wait=%.3fms fork_wait/meal=%.3fms\n",
+		queue_max, (double)wait_total / TICK_MS,
+		(double)wait_total / TICK_MS / meals);
+}
+
+/**
+ * @brief Print how the fork strategy did to stderr (--report)
+ * @param sim The simulation struct
+ * 
+ * @details
+ * meals/s counts every meal started since the simulation began. The worst
+ * wait is the longest any philo took to get his forks. Strategies that
+ * queue philos on the forks ("fifo") add a line about the queues.
+ * 
+ * @attention Shall call after every philo has been joined.
+*/
+void	pl_report(t_simulation *sim)
+{
+	int		i;
+	long	meals;
+	t_tick	worst;
+	t_tick	elapsed;
+
+	i = -1;
+	meals = 0;
+	worst = 0;
+	while (++i < sim->rules->philo_total)
+	{
+		meals += pl_get_meal_count(&sim->philos[i]);
+		if (sim->philos[i].wait_max > worst)
+			worst = sim->philos[i].wait_max;
+	}
+	elapsed = pl_now() - sim->rules->start_time;
+	fprintf(stderr, "fork=%s philos=%d meals=%ld meals/s=%.1f "
+		"worst_wait=%.3fms\n", sim->rules->opts.fork->name,
+		sim->rules->philo_total, meals,
+		(double)meals * TICK_S / elapsed, (double)worst / TICK_MS);
+	pl_report_queues(sim, meals);
+}
+
+/**
+ * @brief Print how big the arena was and how long it took to set the
+ *        table and clear it to stderr (--report)
+ * @param sim The simulation struct, its arena unmapped
+*/
+void	pl_report_arena(t_simulation *sim)
+{
+	fprintf(stderr, "philos=%d arena=%zuKB hugepages=%d setup=%.3fms "
+		"teardown=%.3fms\n", sim->rules->philo_total, sim->arena.size / 1024,
+		sim->rules->opts.huge, (double)sim->arena.setup / TICK_MS,
+		(double)sim->arena.teardown / TICK_MS);
+}
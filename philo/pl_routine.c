@@ -6,75 +6,87 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/13 16:26:09 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/02/20 18:07:28 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 23:18:04 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
-/**
- * @brief Function to handle mutex (fork action)
- * @param philo The philo struct
- * @param act Fork action. take: Lock mutex; return: Unlock mutex.
- * 
- * @details
- * If act is "TAKE", lock mutexes.
- * If act is "RETURN", unlock mutexes.
- * 
- * "Mutexes" here are referring to the left and right fork.
-*/
-void	pl_fork_action(t_philo *philo, t_fork_action act)
-{
-	if (act == TAKE)
-	{
-		pthread_mutex_lock(philo->left_fork);
-		pl_declare_state(philo, FORK);
-		pthread_mutex_lock(philo->right_fork);
-		pl_declare_state(philo, FORK);
-	}
-	else if (act == RETURN)
-	{
-		pthread_mutex_unlock(philo->left_fork);
-		pthread_mutex_unlock(philo->right_fork);
-	}
-}
-
 /**
  * @brief Eat routine of philo
  * @param philo The assigned philo
  * 
  * @details
  * Routine:
- * 1. Take forks (Left & Right)
+ * 1. Take forks (Left & Right), put them back if the simulation ended
+ *    while waiting for them, or go without if the strategy gave up on
+ *    them (the wait is a span of its own, --trace)
  * 2. Update last_ate time before eating (need to protect)
  * 3. Declare EAT as the assigned philo's state
  * 4. Update the meal count; (need to protect)
- * 5. Eat for "time_to_eat"
- * 6. Put down forks (Left & Right)
+ * 5. Check if the philo (and everyone else) is full
+ * 6. Eat until "time_to_eat" after the meal started, or until the
+ *    simulation ends
+ * 7. Put down forks (Left & Right)
+ * 
+ * @return The time the meal ended
 */
-void	pl_eat(t_philo *philo)
+t_tick	pl_eat(t_philo *philo)
 {
-	pl_fork_action(philo, TAKE);
-	pthread_mutex_lock(&philo->last_ate_lock);
-	philo->last_ate = pl_get_time();
-	pthread_mutex_unlock(&philo->last_ate_lock);
+	t_tick	done;
+
+	pl_trace_mark(philo->rules, &philo->trace, SPAN_WAIT, -1);
+	if (pl_fork_action(philo, TAKE) == 0)
+		return (pl_now());
+	if (pl_get_sim_state(philo) == END)
+	{
+		pl_fork_action(philo, RETURN);
+		return (pl_now());
+	}
+	done = pl_now();
+	pl_set_last_ate(philo, done);
+	done += philo->rules->time_to_eat * TICK_MS;
 	pl_declare_state(philo, EAT);
-	pthread_mutex_lock(&philo->meal_count_lock);
-	philo->meal_count++;
-	pthread_mutex_unlock(&philo->meal_count_lock);
-	pl_usleep(philo->rules->time_to_eat);
+	pl_add_meal(philo);
+	pl_full_tracker(philo);
+	pl_nap(philo->rules, done, philo->rules->opts.spin);
 	pl_fork_action(philo, RETURN);
+	return (done);
 }
 
 /**
  * @brief Sleep routine of philo
+ * @param philo The assigned philo
+ * @param from The time the meal ended
  * 
- * Declare state and sleep for "time_to_sleep"
+ * Declare state and sleep until "time_to_sleep" after the meal, or until
+ * the simulation ends if it's sooner. Counting
+ * from the end of the meal rather than from now keeps a late wake up from
+ * adding up over the iterations.
 */
-void	pl_sleep(t_philo *philo)
+void	pl_sleep(t_philo *philo, t_tick from)
 {
 	pl_declare_state(philo, SLEEP);
-	pl_usleep(philo->rules->time_to_sleep);
+	pl_nap(philo->rules, from + philo->rules->time_to_sleep * TICK_MS,
+		philo->rules->opts.spin);
+}
+
+/**
+ * @brief Routine of a philo that sits alone at the table
+ * @param philo The assigned philo
+ * 
+ * @details
+ * There's only one fork on the table, so the left and the right fork are
+ * the same mutex. Take it, and hold it until the monitor declares the
+ * philo dead.
+*/
+static void	pl_dine_alone(t_philo *philo)
+{
+	pl_mutex_lock(&philo->left_fork->lock);
+	pl_declare_state(philo, FORK);
+	while (pl_get_sim_state(philo) != END)
+		pl_nap(philo->rules, pl_now() + TICK_S, 0);
+	pl_mutex_unlock(&philo->left_fork->lock);
 }
 
 /**
@@ -90,8 +102,11 @@ void	pl_sleep(t_philo *philo)
  * to seperate the philosophers into two big group. If the 
  * ID of the philo is odd number, they have to wait for
  * "time_to_eat" time. Else, they can perform the routine first.
+ * Only the "naive" fork strategy needs this, the others can't deadlock.
+ * With --sched=adaptive, a philo instead keeps thinking until his next
+ * slot in the schedule (see t_schedule).
  * 
- * Routine:
+ * Routine, once the start line opens:
  * 1. Eat
  * 2. Sleep
  * 3. Think
@@ -108,17 +123,25 @@ void	*pl_routine(void *arg)
 	t_philo	*philo;
 
 	philo = arg;
-	if (philo->id % 2 != 0)
-		pl_usleep(philo->rules->time_to_eat / 2);
+	pl_start_wait(philo->rules);
+	pl_trace_mark(philo->rules, &philo->trace, SPAN_THINK, -1);
+	if (philo->left_fork == philo->right_fork)
+	{
+		pl_dine_alone(philo);
+		return (NULL);
+	}
+	if (philo->rules->opts.fork->stagger && philo->id % 2 != 0
+		&& philo->rules->opts.sched == STAGGER)
+		pl_nap(philo->rules, philo->rules->start_time
+			+ philo->rules->time_to_eat * TICK_MS / 2, philo->rules->opts.spin);
 	while (1)
 	{
+		if (philo->rules->opts.sched == ADAPTIVE)
+			pl_nap(philo->rules, pl_sched_next(philo),
+				philo->rules->opts.spin);
 		if (pl_get_sim_state(philo) == END)
-		{
-			pl_fork_action(philo, RETURN);
 			break ;
-		}
-		pl_eat(philo);
-		pl_sleep(philo);
+		pl_sleep(philo, pl_eat(philo));
 		pl_declare_state(philo, THINK);
 	}
 	return (NULL);
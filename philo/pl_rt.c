@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_rt.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:03:14 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:03:14 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Say on stderr that a real-time or memory option can't be
+ *        honoured
+ * @param what The option
+ * @param err The error it failed with
+*/
+void	pl_rt_warn(char *what, int err)
+{
+	fprintf(stderr, "warning: %s: %s, going on without it\n", what,
+		strerror(err));
+}
+
+/**
+ * @brief Lock memory, switch to a real-time policy and list the CPUs to
+ *        pin to, as the options ask
+ * @param rules The simulation rules
+ * 
+ * @details
+ * The policy is set on the main thread: every thread it creates after
+ * inherits it. Real-time scheduling and locking memory need privileges
+ * (CAP_SYS_NICE, CAP_IPC_LOCK or rlimits), without them the simulation
+ * still runs, after a warning.
+ * 
+ * @return 1 on success, 0 on error.
+*/
+int	pl_rt_init(t_rules *rules)
+{
+	struct sched_param	param;
+	int					err;
+
+	if (rules->opts.mlock && mlockall(RT_MLOCK) != 0)
+		pl_rt_warn("--mlock", errno);
+	if (rules->opts.rt_policy != SCHED_OTHER)
+	{
+		param.sched_priority = rules->opts.rt_prio;
+		err = pthread_setschedparam(pthread_self(), rules->opts.rt_policy,
+				&param);
+		if (err != 0)
+		{
+			pl_rt_warn("--rt", err);
+			rules->opts.rt_policy = SCHED_OTHER;
+		}
+	}
+	return (pl_rt_cpus(rules));
+}
+
+/**
+ * @brief Pin a thread to its CPU (--affinity)
+ * @param rules The simulation rules
+ * @param thread The thread
+ * @param slot Its slot, 0 to slots - 1
+ * @param slots Number of slots
+ * 
+ * @details
+ * rr deals the CPUs out one after the other, wrapping around. numa cuts
+ * the slots into as many contiguous blocks as there are CPUs: neighbours
+ * share a CPU, or one of the same node, as long as there are few CPUs
+ * per philo.
+*/
+void	pl_rt_pin(t_rules *rules, pthread_t thread, int slot, int slots)
+{
+	cpu_set_t	set;
+	int			index;
+
+	if (rules->cpus.total == 0)
+		return ;
+	index = slot % rules->cpus.total;
+	if (rules->opts.pin == PIN_NUMA)
+		index = (long)slot * rules->cpus.total / slots;
+	CPU_ZERO(&set);
+	CPU_SET(rules->cpus.order[index], &set);
+	pthread_setaffinity_np(thread, sizeof(set), &set);
+}
+
+/**
+ * @brief Give the monitor a priority above the philos (--rt), so that no
+ *        philo busy at a meal keeps a death from being seen
+ * @param rules The simulation rules
+ * @param thread The monitor thread
+*/
+void	pl_rt_boost(t_rules *rules, pthread_t thread)
+{
+	struct sched_param	param;
+
+	if (rules->opts.rt_policy == SCHED_OTHER)
+		return ;
+	param.sched_priority = rules->opts.rt_prio + 1;
+	if (param.sched_priority > 99)
+		param.sched_priority = 99;
+	pthread_setschedparam(thread, rules->opts.rt_policy, &param);
+}
@@ -0,0 +1,74 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_runq.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:38:05 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:38:05 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Set up an empty run queue
+ * @param runq The run queue
+ * @param cap Number of slots, enough for every coroutine
+ * 
+ * @return 1 on success, 0 on error.
+*/
+int	pl_runq_init(t_runq *runq, int cap)
+{
+	runq->head = 0;
+	runq->size = 0;
+	runq->cap = cap;
+	runq->slots = malloc(sizeof(int) * cap);
+	pl_mutex_init(&runq->lock);
+	return (runq->slots != NULL);
+}
+
+/**
+ * @brief Queue a coroutine at the tail
+ * @param runq The run queue
+ * @param index The coroutine
+ * 
+ * @details
+ * A coroutine is only ever in one queue at a time, so the queue can't
+ * overflow.
+*/
+void	pl_runq_push(t_runq *runq, int index)
+{
+	pl_mutex_lock(&runq->lock);
+	runq->slots[(runq->head + runq->size) % runq->cap] = index;
+	runq->size++;
+	pl_mutex_unlock(&runq->lock);
+}
+
+/**
+ * @brief Take a coroutine out of the queue
+ * @param runq The run queue
+ * @param steal 0: the owner takes the oldest one, from the head.
+ *              1: a thief takes the newest one, from the tail.
+ * 
+ * @return The coroutine, -1 if the queue is empty.
+*/
+int	pl_runq_pop(t_runq *runq, int steal)
+{
+	int	index;
+
+	pl_mutex_lock(&runq->lock);
+	index = -1;
+	if (runq->size > 0 && steal)
+		index = runq->slots[(runq->head + runq->size - 1) % runq->cap];
+	else if (runq->size > 0)
+	{
+		index = runq->slots[runq->head];
+		runq->head = (runq->head + 1) % runq->cap;
+	}
+	if (index != -1)
+		runq->size--;
+	pl_mutex_unlock(&runq->lock);
+	return (index);
+}
@@ -0,0 +1,92 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_sched.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:57:41 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:57:41 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Say up front if the rules can be survived (stderr)
+ * @param rules The simulation rules, schedule computed
+*/
+static void	pl_sched_report(t_rules *rules)
+{
+	char	*verdict;
+
+	verdict = "no";
+	if (rules->sched.survivable)
+		verdict = "yes";
+	fprintf(stderr, "sched=adaptive philos=%d at_once=%d period=%.3fms "
+		"die=%dms survivable=%s\n", rules->philo_total,
+		rules->sched.at_once, (double)rules->sched.period / TICK_MS,
+		rules->time_to_die, verdict);
+}
+
+/**
+ * @brief Compute the schedule of --sched=adaptive
+ * @param rules The simulation rules
+ * 
+ * @details
+ * The period is the longest of two bounds no schedule can beat:
+ * philo_total meals of at_once units, at_once philos eating at a time,
+ * and a meal plus a nap. The rules can be survived only if a philo gets
+ * his next meal before he starves, so the period has to be shorter than
+ * time_to_die. A philo alone never eats.
+*/
+void	pl_sched_init(t_rules *rules)
+{
+	t_schedule	*sched;
+	t_tick		meal;
+
+	if (rules->opts.sched != ADAPTIVE)
+		return ;
+	sched = &rules->sched;
+	meal = rules->time_to_eat * TICK_MS;
+	sched->at_once = rules->philo_total / 2;
+	if (sched->at_once == 0)
+		sched->at_once = 1;
+	sched->unit = (meal + sched->at_once - 1) / sched->at_once;
+	sched->period = sched->unit * rules->philo_total;
+	if (sched->period < meal + rules->time_to_sleep * TICK_MS)
+		sched->period = meal + rules->time_to_sleep * TICK_MS;
+	sched->survivable = (rules->philo_total > 1
+			&& sched->period < rules->time_to_die * TICK_MS);
+	pl_sched_report(rules);
+}
+
+/**
+ * @brief The start of a philo's next slot, when he reaches for his forks
+ * @param philo The philo
+ * 
+ * @details
+ * Slots are on a fixed grid from the start of the simulation, so a late
+ * meal doesn't push back the next ones. A philo who fell more than a
+ * period behind (the rules can't be survived) skips to the latest slot
+ * that has begun, instead of eating back to back to catch up.
+ * 
+ * @return The time, in the past if he's late.
+*/
+t_tick	pl_sched_next(t_philo *philo)
+{
+	t_schedule	*sched;
+	t_tick		slot;
+	t_tick		now;
+
+	sched = &philo->rules->sched;
+	if (philo->slot == 0)
+		philo->slot = philo->rules->start_time + (long)philo->id
+			* sched->at_once % philo->rules->philo_total * sched->unit;
+	now = pl_now();
+	if (now - philo->slot >= sched->period)
+		philo->slot += (now - philo->slot) / sched->period * sched->period;
+	slot = philo->slot;
+	philo->slot += sched->period;
+	return (slot);
+}
@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_start.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:13:06 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:13:06 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Wait at the start line until it opens
+ * @param rules The simulation rules
+ * 
+ * @details
+ * A thread spawned after the start line opened goes straight through.
+*/
+void	pl_start_wait(t_rules *rules)
+{
+	while (atomic_load_explicit(&rules->start_line, memory_order_acquire)
+		== 0)
+		pl_futex_wait(&rules->start_line, 0, INT64_MAX);
+}
+
+/**
+ * @brief Start the simulation: every philo (or worker) leaves the start
+ *        line on the same tick
+ * @param sim The simulation struct, every thread spawned
+ * 
+ * @details
+ * Threads are spawned one after the other, a 200 seat table takes a few
+ * ms. Had each philo started on his own, the last ones would have less
+ * slack than the first. Instead they all sleep at the start line until
+ * the main thread opens it, with a single futex wake up. Right before,
+ * it takes the start time, and makes it every philo's last meal, then
+ * spawns the monitor, which sleeps until the first deadline anyway.
+ * If the simulation ended before it began (a thread couldn't be
+ * spawned), or the monitor can't be spawned, the philos leave the start
+ * line to go home.
+ * 
+ * @return 1 on success, 0 on error.
+*/
+int	pl_start_release(t_simulation *sim)
+{
+	t_rules	*rules;
+	t_tick	start;
+	int		i;
+
+	rules = sim->rules;
+	start = pl_now();
+	rules->start_time = start;
+	rules->log.start_time = start;
+	i = -1;
+	while (++i < rules->philo_total)
+		pl_set_last_ate(&sim->philos[i], start);
+	if (atomic_load(&rules->sim_state) != END)
+		sim->watched = pl_spawn_monitor(sim);
+	if (sim->watched == 0)
+		pl_end_simulation_state(rules);
+	atomic_store_explicit(&rules->start_line, 1, memory_order_release);
+	pl_futex_wake(&rules->start_line);
+	return (sim->watched);
+}
@@ -0,0 +1,174 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_trace.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:52:16 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:52:16 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Put a mark on a timeline (--trace)
+ * @param rules The simulation rules
+ * @param trace The timeline, the caller's own
+ * @param span What starts now
+ * @param arg The philo it's about, -1 if none
+ * 
+ * @details
+ * Nothing is shared: a mark costs a clock read and a store, and a realloc
+ * once in a while as the timeline doubles. If that fails, the rest of the
+ * timeline is dropped rather than stopping the simulation.
+*/
+void	pl_trace_mark(t_rules *rules, t_trace *trace, t_span span, int arg)
+{
+	t_mark	*marks;
+	int		cap;
+
+	if (rules->opts.trace == NULL || trace->cap < 0)
+		return ;
+	if (trace->total == trace->cap)
+	{
+		cap = TRACE_CHUNK;
+		if (trace->cap > 0)
+			cap = trace->cap * 2;
+		marks = NULL;
+		if (trace->cap < INT_MAX / 2)
+			marks = realloc(trace->marks, sizeof(t_mark) * cap);
+		if (marks == NULL)
+		{
+			trace->cap = -1;
+			return ;
+		}
+		trace->marks = marks;
+		trace->cap = cap;
+	}
+	trace->marks[trace->total].time = pl_now();
+	trace->marks[trace->total].span = span;
+	trace->marks[trace->total].arg = arg;
+	trace->total++;
+}
+
+/**
+ * @brief Write a mark as a trace event
+ * @param file The trace file
+ * @param mark The mark
+ * @param tid Its track
+ * @param when The start of the simulation, and when the span ends
+ * 
+ * @details
+ * A span is a complete event ("X"), an instant an "i". Times are in us
+ * since the start.
+*/
+static void	pl_trace_event(FILE *file, t_mark *mark, int tid, t_tick *when)
+{
+	static const char	*names[] = {"think", "fork wait", "eat", "sleep",
+		"fork", "check", "nap", "died"};
+
+	fprintf(file, ",\n{\"name\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.3f",
+		names[mark->span], tid, (double)(mark->time - when[0]) / TICK_US);
+	if (mark->span == SPAN_DIED)
+		fprintf(file, ",\"ph\":\"i\",\"s\":\"g\",\"args\":{\"philo\":%d}}",
+			mark->arg + 1);
+	else if (mark->span == SPAN_FORK)
+		fprintf(file, ",\"ph\":\"i\",\"s\":\"t\"}");
+	else
+		fprintf(file, ",\"ph\":\"X\",\"dur\":%.3f}",
+			(double)(when[1] - mark->time) / TICK_US);
+}
+
+/**
+ * @brief Find when the span of a mark ends: at the next mark that isn't
+ *        an instant, or at the end of the simulation for the last one
+ * @param trace The timeline
+ * @param i The mark
+ * @param end The end of the simulation
+ * 
+ * @return When it ends
+*/
+static t_tick	pl_trace_end(t_trace *trace, int i, t_tick end)
+{
+	while (++i < trace->total)
+	{
+		if (trace->marks[i].span != SPAN_FORK
+			&& trace->marks[i].span != SPAN_DIED)
+			return (trace->marks[i].time);
+	}
+	return (end);
+}
+
+/**
+ * @brief Write a timeline, named, as trace events, then free it
+ * @param file The trace file, NULL to only free it
+ * @param trace The timeline
+ * @param tid Its track
+ * @param bounds The start and the end of the simulation
+ * 
+*/
+static void	pl_trace_track(FILE *file, t_trace *trace, int tid,
+		t_tick *bounds)
+{
+	t_tick	when[2];
+	int		i;
+
+	if (file == NULL)
+		trace->total = 0;
+	else if (tid == 0)
+		fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+			"\"tid\":0,\"args\":{\"name\":\"monitor\"}}");
+	else
+		fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+			"\"tid\":%d,\"args\":{\"name\":\"philo %d\"}}", tid, tid);
+	when[0] = bounds[0];
+	i = -1;
+	while (++i < trace->total)
+	{
+		when[1] = pl_trace_end(trace, i, bounds[1]);
+		pl_trace_event(file, &trace->marks[i], tid, when);
+	}
+	free(trace->marks);
+	trace->marks = NULL;
+}
+
+/**
+ * @brief Write every timeline to the trace file (--trace), as Chrome
+ *        trace events
+ * @param sim The simulation struct
+ * 
+ * @details
+ * A track per philo (tid is his ID) and one for the monitor (tid 0), for
+ * chrome://tracing or ui.perfetto.dev to open. A timeline cut short by a
+ * failed realloc just stops early. If the file can't be written, there's
+ * a warning and no trace.
+ * 
+ * @attention Shall call once every philo and the monitor have been
+ *            joined.
+*/
+void	pl_trace_write(t_simulation *sim)
+{
+	FILE	*file;
+	t_tick	bounds[2];
+	int		i;
+
+	bounds[0] = sim->rules->start_time;
+	bounds[1] = pl_now();
+	file = fopen(sim->rules->opts.trace, "w");
+	if (file == NULL)
+		pl_rt_warn("--trace", errno);
+	if (file != NULL)
+		fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+			"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+			"\"args\":{\"name\":\"philo\"}}");
+	i = -1;
+	pl_trace_track(file, &sim->watch, 0, bounds);
+	while (++i < sim->rules->philo_total)
+		pl_trace_track(file, &sim->philos[i].trace, i + 1, bounds);
+	if (file != NULL)
+		fprintf(file, "\n]}\n");
+	if (file != NULL && fclose(file) != 0)
+		pl_rt_warn("--trace", errno);
+}
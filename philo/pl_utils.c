@@ -6,7 +6,7 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/13 10:38:17 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/02/22 11:23:37 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 22:19:52 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -70,37 +70,35 @@ int	ft_isdigit_str(char *str)
 }
 
 /**
- * @brief Get current time in seconds
+ * @brief Allocate an array that starts on a cache line
+ * @param count Number of elements
+ * @param size Size of one element
  * 
- * @return Time in time_t format
+ * @details
+ * malloc only promises 16 bytes alignment, not enough for the PL_LINE
+ * structs. The size is rounded up to a whole cache line as aligned_alloc
+ * wants it to be a multiple of the alignment.
+ * 
+ * @return The array (free it with free), NULL if the allocation failed.
 */
-time_t	pl_get_time(void)
+void	*pl_alloc_lines(size_t count, size_t size)
 {
-	struct timeval	time;
-
-	gettimeofday(&time, NULL);
-	return ((time.tv_sec * 1000) + (time.tv_usec / 1000));
+	size = (count * size + PL_CACHE_LINE - 1) & ~(size_t)(PL_CACHE_LINE - 1);
+	return (aligned_alloc(PL_CACHE_LINE, size));
 }
 
 /**
- * @brief A better usleep
+ * @brief Set a mutex up, from the static initialiser (its stats at 0
+ *        with LOCKSTAT=1)
+ * @param mutex The mutex
  * 
  * @details
- * Through some experiments as well as peer's observation, it seems like
- * usleep is not that accurate in some case. Usleep might "overslept", which
- * makes the timestamp of the program less accurate. Hence, to prevent this
- * situation, the idea is to let usleep to sleep a constant amount of time
- * and check if the program has slept for what's required.
+ * Copying the initialiser in can't fail, and doesn't call into the
+ * library: there are three mutexes per seat.
 */
-void	pl_usleep(time_t sec)
+void	pl_mutex_init(t_mutex *mutex)
 {
-	time_t	cur_time;
+	static const t_mutex	unlocked = PL_MUTEX_INIT;
 
-	cur_time = pl_get_time();
-	while (1)
-	{
-		usleep(500);
-		if ((pl_get_time() - cur_time) >= sec)
-			break ;
-	}
+	*mutex = unlocked;
 }
@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_worker.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:38:44 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:18:04 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * @brief Find the next coroutine to run
+ * @param worker The worker
+ * 
+ * @details
+ * 1. Sleeping coroutines whose time has come join the run queue
+ * 2. Take the oldest coroutine of the run queue
+ * 3. If there's none, steal the newest one of another worker
+ * 
+ * @return The coroutine, NULL if there's nothing to run.
+*/
+static t_coro	*pl_worker_next(t_worker *worker)
+{
+	t_pool	*pool;
+	t_tick	now;
+	int		index;
+	int		i;
+
+	pool = worker->pool;
+	now = pl_now();
+	while (worker->timers.size > 0 && worker->timers.nodes[0].key <= now)
+	{
+		pl_runq_push(&worker->runq, worker->timers.nodes[0].val);
+		pl_heap_pop(&worker->timers);
+	}
+	index = pl_runq_pop(&worker->runq, 0);
+	i = 0;
+	while (index == -1 && ++i < pool->worker_total)
+		index = pl_runq_pop(&pool->workers[(worker->id + i)
+				% pool->worker_total].runq, 1);
+	if (index == -1)
+		return (NULL);
+	return (&pool->coros[index]);
+}
+
+/**
+ * @brief Park a coroutine that just handed control back
+ * @param worker The worker
+ * @param coro The coroutine
+ * 
+ * @details
+ * This is done here, once the coroutine's context is saved, and not by
+ * the coroutine itself: as soon as it's parked on a fork, another worker
+ * may hand it the fork and resume it.
+ * A sleeping coroutine waits in the worker's timers. A coroutine waiting
+ * for a fork is left to whoever puts the fork down, unless the fork was
+ * put down in the meantime.
+*/
+static void	pl_worker_park(t_worker *worker, t_coro *coro)
+{
+	t_fork	*fork;
+
+	if (coro->park == PARK_SLEEP)
+		pl_heap_push(&worker->timers, coro->wake, coro->philo->id);
+	if (coro->park != PARK_FORK)
+		return ;
+	fork = coro->fork;
+	pl_mutex_lock(&fork->lock);
+	if (fork->in_use)
+		fork->waiter = coro;
+	else
+	{
+		fork->in_use = 1;
+		pl_runq_push(&worker->runq, coro->philo->id);
+	}
+	pl_mutex_unlock(&fork->lock);
+}
+
+/**
+ * @brief Nothing to run: sleep until the first timer of the worker, or
+ *        CORO_IDLE at most to look for work to steal again
+ * @param worker The worker
+*/
+static void	pl_worker_idle(t_worker *worker)
+{
+	t_tick	until;
+
+	until = pl_now() + CORO_IDLE;
+	if (worker->timers.size > 0 && worker->timers.nodes[0].key < until)
+		until = worker->timers.nodes[0].key;
+	pl_nap(worker->pool->sim->rules, until,
+		worker->pool->sim->rules->opts.spin);
+}
+
+/**
+ * @brief Routine of a worker thread
+ * @param arg The worker
+ * 
+ * @details
+ * Once the start line opens, run coroutines until the
+ * simulation ends. A coroutine runs until it
+ * sleeps, waits for a fork or is done, then hands control back here.
+ * Coroutines still parked at the end are simply dropped, they never hold
+ * a lock while parked.
+*/
+void	*pl_worker(void *arg)
+{
+	t_worker	*worker;
+	t_coro		*coro;
+
+	worker = arg;
+	pl_start_wait(worker->pool->sim->rules);
+	while (pl_get_sim_state(worker->pool->sim->philos) != END)
+	{
+		coro = pl_worker_next(worker);
+		if (coro == NULL)
+			pl_worker_idle(worker);
+		else
+		{
+			coro->worker = worker;
+			swapcontext(&worker->ctx, &coro->ctx);
+			pl_worker_park(worker, coro);
+		}
+	}
+	return (NULL);
+}
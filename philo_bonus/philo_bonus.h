@@ -6,7 +6,7 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/24 11:06:53 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/03/03 18:21:53 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 23:18:04 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,15 +14,30 @@
 # define PHILO_BONUS_H
 
 /* ====== LIBRARIES ====== */
+/* CPU affinity (--affinity) is a GNU extension */
+# ifndef _GNU_SOURCE
+#  define _GNU_SOURCE
+# endif
 # include <stdio.h>
 # include <string.h>
 # include <stdlib.h>
 # include <unistd.h>
-# include <sys/time.h>
+# include <fcntl.h>
 # include <sys/wait.h>
 # include <signal.h>
 # include <pthread.h>
 # include <semaphore.h>
+# include <sys/mman.h>
+# include <stdatomic.h>
+# include <limits.h>
+# include <stdint.h>
+# include <time.h>
+# include <sched.h>
+# include <sys/epoll.h>
+# include <sys/signalfd.h>
+# include <sys/eventfd.h>
+# include <sys/timerfd.h>
+# include <errno.h>
 
 /* ====== TEXT STYLING ====== */
 # define RED "\033[1;31m"
@@ -36,11 +51,57 @@
 
 /* ====== MACROS ====== */
 # define FORK_SEM "/fork_sem"
-# define DECLARE_SEM "/declare_sem"
-# define SIM_SEM "/sim_sem"
-# define FULL_SEM "/full_sem"
+# define GATE_SEM "/gate_sem"
 # define LAST_ATE_SEM "/lastate_sem"
-# define DEATH_SEM "/death_sem"
+
+/**
+ * LOG_RING_SIZE	Events each philo can have in flight (power of two)
+ * LOG_BUF_SIZE		Size of the log writer's output buffer
+ * LOG_FLUSH_US		How often (us) the log writer drains the rings
+ * LOG_IDLE			Pending time of a ring that is not logging anything
+ * LOG_BIN_RECORD	Size of an event in the binary format (--format=bin)
+*/
+# define LOG_RING_SIZE 256
+# define LOG_BUF_SIZE 65536
+# define LOG_FLUSH_US 1000
+# define LOG_IDLE INT64_MAX
+# define LOG_BIN_RECORD 13
+
+/**
+ * SERVE_MAX	Most philos a server (--serve) keeps warm
+ * SERVE_LINE	Longest rule line a server reads, the rest is cut
+ * SERVE_WORDS	Most words in a rule line
+*/
+# define SERVE_MAX 10000
+# define SERVE_LINE 256
+# define SERVE_WORDS 16
+
+/**
+ * RT_PRIO		Priority of philos with --rt=<policy> and no :<prio>
+ * RT_NODE_MAX	Most NUMA nodes looked up by --affinity=numa
+ * RT_MLOCK		What --mlock locks: every page, now and to come, once it's
+ * 				touched (thread stacks aren't filled up front)
+*/
+# define RT_PRIO 10
+# define RT_NODE_MAX 64
+# define RT_MLOCK (MCL_CURRENT | MCL_FUTURE | MCL_ONFAULT)
+
+/**
+ * TICK_US	Ticks (ns) in one microsecond
+ * TICK_MS	Ticks (ns) in one millisecond
+ * TICK_S	Ticks (ns) in one second
+*/
+# define TICK_US 1000LL
+# define TICK_MS 1000000LL
+# define TICK_S 1000000000LL
+
+/* ====== TYPES ====== */
+
+/**
+ * @brief A point in time: nanoseconds on the monotonic clock.
+ *        Converted to milliseconds only when printed.
+*/
+typedef int64_t	t_tick;
 
 /* ====== ENUMS ====== */
 
@@ -95,6 +156,75 @@ typedef enum e_lock_type
 	MEAL
 }		t_lock_type;
 
+/**
+ * @brief Enum for the output formats (--format)
+ * 
+ * @param TEXT	"%8ld %3d <message>" with colours, for humans (default)
+ * @param PLAIN	"<ms> <id> <message>", no colours
+ * @param CSV	"<us>,<id>,<state>" after a header line
+ * @param BIN	Fixed size records, see pl_format_event
+*/
+typedef enum e_format
+{
+	TEXT,
+	PLAIN,
+	CSV,
+	BIN
+}		t_format;
+
+/**
+ * @brief Enum for where the semaphores live (--sem)
+ * 
+ * @param NAMED	sem_open names in /dev/shm (default)
+ * @param ANON	Unnamed, process-shared, in one shared mapping
+*/
+typedef enum e_sem_backend
+{
+	NAMED,
+	ANON
+}		t_sem_backend;
+
+/**
+ * @brief Enum for how the forks are modeled (--fork)
+ * 
+ * @param POOL		One counting semaphore, any two forks will do (default)
+ * @param ADJACENT	A philo eats with his own two forks, see t_table
+*/
+typedef enum e_fork_mode
+{
+	POOL,
+	ADJACENT
+}		t_fork_mode;
+
+/**
+ * @brief Enum for what a philo is doing about his forks (--fork=adjacent)
+ * 
+ * @param SEAT_IDLE		Not after his forks
+ * @param SEAT_HUNGRY	Waiting for both of his forks
+ * @param SEAT_EATING	Holding both of his forks
+*/
+typedef enum e_seat
+{
+	SEAT_IDLE,
+	SEAT_HUNGRY,
+	SEAT_EATING
+}		t_seat;
+
+/**
+ * @brief Enum for how philos are pinned to CPUs (--affinity)
+ * 
+ * @param PIN_NONE	Left to the scheduler (default)
+ * @param PIN_RR	Round-robin over the allowed CPUs
+ * @param PIN_NUMA	Neighbours on the same NUMA node, CPUs handed out node
+ * 					by node in contiguous blocks
+*/
+typedef enum e_pin
+{
+	PIN_NONE,
+	PIN_RR,
+	PIN_NUMA
+}		t_pin;
+
 /**
  * @brief Enum for errors
  * 
@@ -102,6 +232,10 @@ typedef enum e_lock_type
  * @param NON_NUMERIC_ARGS		Consists of non numeric arguments
  * @param NEGATIVE_ARGS			Consists of non positive numeric arguments
  * @param INVALID_OPTION		Optional option not more than 0
+ * @param INVALID_FLAG			Unknown or malformed --name=value option
+ * @param TOO_MANY_PHILOS		A run needs more philos than a server keeps
+ * @param REACTOR_FAILED		Failed to set up the reactor (epoll, signalfd)
+ * @param BARRIER_FAILED		Failed to set up the start line
  * @param CREATE_THD_FAILED		Failed to create thread
  * @param CREATE_MUT_FAILED		Failed to create mutex
  * @param DESTROY_MUT_FAILED	Failed to destroy mutex
@@ -112,8 +246,13 @@ typedef enum e_error
 	NON_NUMERIC_ARGS,
 	NEGATIVE_ARGS,
 	INVALID_OPTION,
+	INVALID_FLAG,
+	TOO_MANY_PHILOS,
 	OPEN_SEM_FAILED,
+	MMAP_FAILED,
 	FORK_FAILED,
+	REACTOR_FAILED,
+	BARRIER_FAILED,
 	CREATE_THD_FAILED,
 	ERROR_TOTAL
 }		t_error;
@@ -121,18 +260,205 @@ typedef enum e_error
 /* ====== STRUCTS ====== */
 
 /**
- * @brief A struct that store all the additional mutexes (shared)
+ * @brief A state change of a philo, waiting to be printed
  * 
- * @param declare_lock		Philo's declare mutex
- * @param sim_state_lock	Philo's simulation state mutex
+ * @param time	 When it happened
+ * @param id	 The philo ID (starts from 0)
+ * @param state	 The new state of the philo
 */
-typedef struct s_locks
+typedef struct s_event
 {
-	sem_t	*declare_sem;
-	sem_t	*sim_sem;
-	sem_t	*full_sem;
-	sem_t	*death_sem;
-}		t_locks;
+	t_tick	time;
+	int		id;
+	t_state	state;
+}		t_event;
+
+/**
+ * @brief Single producer, single consumer ring of events
+ * 
+ * @param head		Next event to be read (parent's log writer only)
+ * @param tail		Next free slot (owner philo only)
+ * @param pending	Time the owner started logging an event, or LOG_IDLE
+ * @param events	The events
+*/
+typedef struct s_ring
+{
+	atomic_size_t	head;
+	atomic_size_t	tail;
+	_Atomic t_tick	pending;
+	t_event			events[LOG_RING_SIZE];
+}		t_ring;
+
+/**
+ * @brief The logger. It lives in memory shared by every process: each
+ *        child pushes its events into its own ring, a writer thread in
+ *        the parent merges the rings by time and prints them.
+ * 
+ * @param start			The start time of the simulation, set when the
+ * 						philos leave the start line
+ * @param start_line	Where the children wait for the start, with the
+ * 						parent (process-shared barrier)
+ * @param rings			One ring per philo (right after the logger)
+ * @param ring_total	Number of rings
+ * @param halt			The event that ends the log (DIED or FULL)
+ * @param halted		0: running, 1: halt being recorded, 2: halt recorded
+ * @param stop			Set to stop the writer
+ * @param full			Number of philo that are full
+ * @param size			Size of the shared mapping
+ * @param stage			Events waiting to be printed (parent only)
+ * @param staged		Number of staged events (parent only)
+ * @param buf			Output buffer (parent only)
+ * @param len			Number of bytes in buf (parent only)
+ * @param done			The halt has been printed (parent only)
+ * @param writer		The writer thread (parent only)
+ * @param format		How events are printed
+*/
+typedef struct s_log
+{
+	t_tick				start;
+	pthread_barrier_t	start_line;
+	t_ring				*rings;
+	int					ring_total;
+	t_event				halt;
+	atomic_int			halted;
+	atomic_int			stop;
+	atomic_int			full;
+	size_t				size;
+	t_event				*stage;
+	int					staged;
+	char				*buf;
+	int					len;
+	int					done;
+	pthread_t			writer;
+	t_format			format;
+}		t_log;
+
+/**
+ * @brief Optional settings, given as `--name=value` after the arguments
+ * 
+ * @param spin		How long before a wake up a philo stops sleeping and
+ * 					yields the CPU until the deadline instead (ticks)
+ * @param format	How events are printed
+ * @param serve		Server mode: number of philos kept warm, 0 if off
+ * @param sem		Where the semaphores live
+ * @param fork		How the forks are modeled
+ * @param pin		How philos are pinned to CPUs
+ * @param rt_policy	SCHED_FIFO or SCHED_RR (--rt), SCHED_OTHER if off
+ * @param rt_prio	Real-time priority of the philos, monitors get one more
+ * @param mlock		Lock every page in memory (--mlock)
+*/
+typedef struct s_options
+{
+	t_tick			spin;
+	t_format		format;
+	int				serve;
+	t_sem_backend	sem;
+	t_fork_mode		fork;
+	t_pin			pin;
+	int				rt_policy;
+	int				rt_prio;
+	int				mlock;
+}		t_options;
+
+/**
+ * @brief The CPUs philos get pinned to (--affinity)
+ * 
+ * @param order	The allowed CPUs, in the order they're handed out
+ * @param total	Number of CPUs, 0 if philos aren't pinned
+*/
+typedef struct s_cpus
+{
+	int	*order;
+	int	total;
+}		t_cpus;
+
+/**
+ * @brief The unnamed semaphores (--sem=anon), handed out in order from
+ *        one mapping shared by every process
+ * 
+ * @param slots	The semaphores
+ * @param used	Number of semaphores handed out
+ * @param total	Number of semaphores mapped
+ * @param size	Size of the shared mapping
+*/
+typedef struct s_sem_pool
+{
+	sem_t	*slots;
+	int		used;
+	int		total;
+	size_t	size;
+}		t_sem_pool;
+
+/**
+ * @brief The parent's reactor: it sleeps until a child exits, then ends
+ *        the simulation
+ * 
+ * @param epfd	The epoll instance
+ * @param sigfd	SIGCHLD as a file descriptor (signalfd)
+ * @param evfd	Written by a philo when a run is over (server mode), -1
+ * 				otherwise
+ * @param pgid	Process group of the children, 0 until the first fork
+*/
+typedef struct s_reactor
+{
+	int		epfd;
+	int		sigfd;
+	int		evfd;
+	pid_t	pgid;
+}		t_reactor;
+
+/**
+ * @brief What the server and its warm philos share (--serve). It lives
+ *        in memory shared by every process, the semaphores right after.
+ * 
+ * @param start			The start time of the current run
+ * @param philo_total	Number of philos in the current run
+ * @param time_to_die	Time to die in ms
+ * @param time_to_eat	Time to eat in ms
+ * @param time_to_sleep	Time to sleep in ms
+ * @param iteration		Number of simulation
+ * @param over			Set by the server to end the current run
+ * @param idle			Posted by every philo of a run once it's done
+ * @param go			One per philo, posted to start a run
+ * @param wake			One per philo, posted to cut a sleep short
+ * @param size			Size of the shared mapping
+*/
+typedef struct s_board
+{
+	t_tick		start;
+	int			philo_total;
+	int			time_to_die;
+	int			time_to_eat;
+	int			time_to_sleep;
+	int			iteration;
+	atomic_int	over;
+	sem_t		idle;
+	sem_t		*go;
+	sem_t		*wake;
+	size_t		size;
+}		t_board;
+
+/**
+ * @brief The table of --fork=adjacent. It lives in memory shared by
+ *        every process, the semaphores and seats right after.
+ * 
+ * @param lock	Guards the seats
+ * @param turn	One per philo, posted when he holds both of his forks
+ * @param seats	One per philo, what he's doing about his forks
+ * @param size	Size of the shared mapping
+ * 
+ * @details
+ * Fork i is held whenever philo i or philo i + 1 is SEAT_EATING, so a
+ * philo becomes SEAT_EATING only when neither neighbour is: both forks
+ * or none.
+*/
+typedef struct s_table
+{
+	sem_t	lock;
+	sem_t	*turn;
+	t_seat	*seats;
+	size_t	size;
+}		t_table;
 
 /**
  * @brief Struct for the simulation rules
@@ -143,18 +469,33 @@ typedef struct s_locks
  * @param time_to_eat 	Time to eat in ms
  * @param time_to_sleep Time to sleep in ms
  * @param iteration 	Number of simulation
+ * @param forks 		The forks, any two will do (--fork=pool)
+ * @param gate 			Lets one philo at a time take his two forks
+ * @param log 			The logger (shared memory)
+ * @param reactor 		The parent's reactor
+ * @param board 		Shared with the server, NULL unless --serve
+ * @param sems 			The unnamed semaphores (--sem=anon)
+ * @param table 		The table, NULL unless --fork=adjacent
+ * @param cpus 			The CPUs philos get pinned to (--affinity)
+ * @param opts 			Optional settings
 */
 typedef struct s_rules
 {
-	struct timeval	start_time;
+	t_tick			start_time;
 	int				philo_total;
 	int				time_to_die;
 	int				time_to_eat;
 	int				time_to_sleep;
 	int				iteration;
-	t_locks			locks;
 	sem_t			*forks;
-	pid_t			*pids;
+	sem_t			*gate;
+	t_log			*log;
+	t_reactor		reactor;
+	t_board			*board;
+	t_sem_pool		sems;
+	t_table			*table;
+	t_cpus			cpus;
+	t_options		opts;
 }		t_rules;
 
 /**
@@ -168,6 +509,7 @@ typedef struct s_rules
  * @param left_fork 		Left fork (mutex), own index's fork
  * @param right_fork		Right fork (mutex) own index - 1's fork
  * @param locks				The additional locks that prevent data race
+ * @param timer				The monitor's timerfd, -1 until the child makes it
  * @param rules 			The simulation rules
  * 
  * @attention These info should be private for each philo only
@@ -178,8 +520,9 @@ typedef struct s_philo
 	int				id;
 	int				meal_count;
 	int				full;
-	struct timeval	last_ate;
+	t_tick			last_ate;
 	sem_t			*last_ate_sem;
+	int				timer;
 	t_rules			*rules;
 }		t_philo;
 
@@ -202,32 +545,86 @@ typedef struct s_simulation
 
 // Parse
 int		pl_parse(int ac, char **av, t_rules *rules);
+int		pl_parse_rules(int ac, char **av, t_rules *rules);
+int		pl_parse_options(int ac, char **av, t_options *opts);
+int		pl_parse_choice(char *arg, t_options *opts);
+int		pl_parse_rt(char *arg, t_options *opts);
+char	*pl_opt_value(char *arg, char *name);
 
 // Philos
 void	pl_begin_simulation(t_rules *rules);
 
 // Philos action
 void	pl_routine(t_philo *philo);
+void	pl_dine(t_philo *philo);
+
+// Server mode
+void	pl_serve(t_rules *rules);
+int		pl_serve_run(t_rules *rules);
+int		pl_serve_line(char *line, char **words);
+void	pl_serve_philo(t_philo *philo);
+int		pl_over(t_rules *rules);
+void	pl_nap(t_philo *philo, t_tick deadline);
+void	pl_philo_done(t_philo *philo);
+int		pl_philo_init(t_simulation *sim, t_philo *philo, int id);
+
+// Table (--fork=adjacent)
+int		pl_table_init(t_rules *rules, int philo_total);
+void	pl_table_reset(t_table *table, int philo_total);
+void	pl_table_take(t_philo *philo);
+void	pl_table_put(t_philo *philo);
 
 // Monitor
-void	*pl_monitor(void *philo);
-void	pl_check_full(t_rules *rules);
-int		pl_monitor_sim(t_rules *rules);
-void	pl_kill_philos(t_rules *rules, pid_t exclude);
+int		pl_monitor_start(t_philo *philo, pthread_t *monitor);
+void	pl_monitor_wake(t_philo *philo);
+
+// Start line
+int		pl_start_init(t_rules *rules);
+void	pl_start_wait(t_philo *philo);
+void	pl_start_release(t_rules *rules);
+
+// Real-time (--affinity, --rt, --mlock)
+int		pl_rt_init(t_rules *rules);
+void	pl_rt_child(t_philo *philo, int slots);
+void	pl_rt_boost(t_rules *rules, pthread_t thread);
+int		pl_rt_cpus(t_rules *rules);
+
+// Reactor
+int		pl_reactor_init(t_reactor *reactor, int events);
+void	pl_reactor_adopt(t_reactor *reactor, pid_t pid);
+int		pl_reactor_wait(t_reactor *reactor);
+void	pl_reactor_stop(t_reactor *reactor, int total);
 
 // Semaphore
-int		pl_setup_shared_sem(t_locks *locks);
+int		pl_sem_init(t_rules *rules, int philo_total);
+int		pl_sem_open(t_rules *rules, sem_t **sem, char *name, int value);
+void	pl_sem_release(t_rules *rules);
 int		pl_setup_philo_sem(t_philo *philo);
 
 // Message
 int		pl_show_error(t_error error, int id);
 void	pl_declare_state(t_philo *philo, t_state state);
+int		pl_format_event(char *buf, t_event *event, t_tick start,
+			t_format format);
+int		pl_format_header(char *buf, t_format format);
+
+// Log
+int		pl_log_init(t_log **log, int ring_total, t_tick start,
+			t_format format);
+void	pl_log_reset(t_log *log, int ring_total, t_tick start);
+int		pl_log_start(t_log *log);
+void	pl_log_stop(t_log *log);
+void	pl_log_push(t_log *log, int id, t_state state);
+void	pl_log_halt(t_log *log, int id, t_state state);
+void	pl_log_flush(t_log *log, int final);
 
 // Utils
-int		pl_get_timestamp(struct timeval before);
-void	pl_usleep(int sec);
-int		pl_sem_open(sem_t **sem, char *name, int value);
 char	*ft_itoa(int n);
 char	*ft_strjoin(char const *s1, char const *s2);
 
+// Clock
+t_tick	pl_now(void);
+long	pl_tick_to_ms(t_tick tick);
+void	pl_sleep_until(t_tick deadline, t_tick spin);
+
 #endif
\ No newline at end of file
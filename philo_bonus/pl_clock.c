@@ -0,0 +1,68 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_clock.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:14:10 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:18:21 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Get the current time on the monotonic clock
+ * 
+ * @details
+ * CLOCK_MONOTONIC is never stepped by NTP or the user, so a philo can't
+ * be "killed" by a clock adjustment. glibc serves clock_gettime through
+ * the vDSO, so this is a plain memory read, not a syscall.
+ * 
+ * @return The time in ticks (ns)
+*/
+t_tick	pl_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((t_tick)ts.tv_sec * TICK_S + ts.tv_nsec);
+}
+
+/**
+ * @brief Convert ticks to milliseconds (rounded down)
+ * @param tick Duration in ticks
+ * 
+ * @return The duration in ms
+*/
+long	pl_tick_to_ms(t_tick tick)
+{
+	return (tick / TICK_MS);
+}
+
+/**
+ * @brief Sleep until an absolute deadline
+ * @param deadline The time to wake up (ticks)
+ * @param spin Stop sleeping this long before the deadline and yield the
+ *             CPU until it instead (ticks, 0 to only sleep)
+ * 
+ * @details
+ * One clock_nanosleep on an absolute deadline replaces the old
+ * usleep(500) polling: a sleep costs one wake up instead of two thousand a
+ * second, and since the deadline is absolute, a wake up that comes late
+ * doesn't push back the next one. The loop only repeats when a signal
+ * interrupts the sleep. The kernel may still wake us a little late (timer
+ * slack), which is what the spin budget buys back.
+*/
+void	pl_sleep_until(t_tick deadline, t_tick spin)
+{
+	struct timespec	ts;
+
+	ts.tv_sec = (deadline - spin) / TICK_S;
+	ts.tv_nsec = (deadline - spin) % TICK_S;
+	while (pl_now() < deadline - spin)
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+	while (pl_now() < deadline)
+		sched_yield();
+}
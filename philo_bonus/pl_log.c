@@ -0,0 +1,134 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_log.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:12:44 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:50:44 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Routine of the log writer thread (parent process)
+ * @param arg The logger
+ * 
+ * @details
+ * Drain the rings every LOG_FLUSH_US until asked to stop. The last flush
+ * is done once every child is gone, so nothing is left behind.
+*/
+static void	*pl_log_writer(void *arg)
+{
+	t_log	*log;
+
+	log = arg;
+	while (atomic_load_explicit(&log->stop, memory_order_acquire) == 0)
+	{
+		pl_log_flush(log, 0);
+		usleep(LOG_FLUSH_US);
+	}
+	pl_log_flush(log, 1);
+	return (NULL);
+}
+
+/**
+ * @brief Empty the logger for a new simulation
+ * @param log The logger
+ * @param ring_total Number of rings in use, at most as many as mapped
+ * @param start The start time of the simulation
+ * 
+ * @attention
+ * Shall call in parent while no child logs (before forking, or between
+ * two runs of a server).
+*/
+void	pl_log_reset(t_log *log, int ring_total, t_tick start)
+{
+	int	i;
+
+	log->start = start;
+	log->ring_total = ring_total;
+	atomic_store(&log->halted, 0);
+	atomic_store(&log->stop, 0);
+	atomic_store(&log->full, 0);
+	i = -1;
+	while (++i < ring_total)
+	{
+		atomic_store(&log->rings[i].head, 0);
+		atomic_store(&log->rings[i].tail, 0);
+		atomic_store(&log->rings[i].pending, LOG_IDLE);
+	}
+}
+
+/**
+ * @brief Map the logger and its rings in memory shared with the children
+ * @param log Where to store the logger
+ * @param ring_total Number of rings (one per philo)
+ * @param start The start time of the simulation
+ * @param format How events are printed
+ * 
+ * @attention
+ * Shall call in parent before forking, so that every child sees the
+ * same mapping.
+ * 
+ * @return 1 if the logger is ready. 0 if there's an error.
+*/
+int	pl_log_init(t_log **log, int ring_total, t_tick start,
+		t_format format)
+{
+	size_t	size;
+	t_log	*lg;
+
+	size = sizeof(t_log) + sizeof(t_ring) * ring_total;
+	lg = mmap(NULL, size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (lg == MAP_FAILED)
+		return (pl_show_error(MMAP_FAILED, -1));
+	lg->size = size;
+	lg->format = format;
+	lg->rings = (t_ring *)(lg + 1);
+	pl_log_reset(lg, ring_total, start);
+	*log = lg;
+	return (1);
+}
+
+/**
+ * @brief Start the writer thread
+ * @param log The logger
+ * 
+ * @attention
+ * Shall call in parent after every child is forked.
+ * 
+ * @return 1 if the writer is running. 0 if there's an error.
+*/
+int	pl_log_start(t_log *log)
+{
+	log->staged = 0;
+	log->done = 0;
+	log->stage = malloc(sizeof(t_event) * log->ring_total * LOG_RING_SIZE);
+	log->buf = malloc(LOG_BUF_SIZE);
+	if (log->stage == NULL || log->buf == NULL)
+		return (0);
+	log->len = pl_format_header(log->buf, log->format);
+	if (pthread_create(&log->writer, NULL, &pl_log_writer, log) != 0)
+		return (pl_show_error(CREATE_THD_FAILED, -1));
+	return (1);
+}
+
+/**
+ * @brief Stop the writer thread, after a last flush
+ * @param log The logger
+ * 
+ * @attention
+ * Call only once no child can log anymore (every child is killed, or
+ * idle for a server). The mapping stays, unmap it with log->size.
+*/
+void	pl_log_stop(t_log *log)
+{
+	atomic_store_explicit(&log->stop, 1, memory_order_release);
+	pthread_join(log->writer, NULL);
+	free(log->stage);
+	free(log->buf);
+}
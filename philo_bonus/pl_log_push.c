@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_log_push.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:12:44 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:15:22 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Push an event into the philo's own ring
+ * @param log The logger
+ * @param id The philo ID
+ * @param state The new state of the philo
+ * 
+ * @details
+ * Before taking the timestamp, the philo publishes the time it started
+ * logging (pending). The writer never prints anything newer than the
+ * oldest pending time, which keeps the output in timestamp order even
+ * though every process fills its ring on its own.
+ * If the ring is full, wait for the writer to make some room.
+*/
+void	pl_log_push(t_log *log, int id, t_state state)
+{
+	t_ring	*ring;
+	size_t	tail;
+	t_event	*event;
+
+	if (atomic_load_explicit(&log->halted, memory_order_acquire) != 0)
+		return ;
+	ring = &log->rings[id];
+	atomic_store(&ring->pending, pl_now());
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	while (tail - atomic_load_explicit(&ring->head, memory_order_acquire)
+		>= LOG_RING_SIZE)
+		usleep(100);
+	event = &ring->events[tail & (LOG_RING_SIZE - 1)];
+	event->time = pl_now();
+	event->id = id;
+	event->state = state;
+	atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+	atomic_store_explicit(&ring->pending, LOG_IDLE, memory_order_release);
+}
+
+/**
+ * @brief Record the event that ends the log
+ * @param log The logger
+ * @param id The philo ID
+ * @param state DIED (printed) or FULL (not printed)
+ * 
+ * @details
+ * Only the first call, across every process, wins. Every event that
+ * happened before the halt is still printed, everything after it is
+ * dropped.
+*/
+void	pl_log_halt(t_log *log, int id, t_state state)
+{
+	int	expected;
+
+	expected = 0;
+	if (atomic_compare_exchange_strong(&log->halted, &expected, 1) == 0)
+		return ;
+	log->halt.time = pl_now();
+	log->halt.id = id;
+	log->halt.state = state;
+	atomic_store_explicit(&log->halted, 2, memory_order_release);
+}
@@ -6,7 +6,7 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/24 10:46:32 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/02/25 17:11:42 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -27,7 +27,9 @@
  * @brief The main function
  * 
  * 1. Parse the inputs and set the rules
- * 2. Begin the simulation based on the rules set
+ * 2. Lock memory, and go real-time and list the CPUs if asked to
+ * 3. Begin the simulation based on the rules set, or serve rule lines
+ *    from stdin to a pool of warm philos (--serve)
 */
 int	main(int ac, char **av)
 {
@@ -35,6 +37,12 @@ int	main(int ac, char **av)
 
 	if (pl_parse(--ac, ++av, &rules) == 0)
 		return (EXIT_FAILURE);
-	pl_begin_simulation(&rules);
+	if (pl_rt_init(&rules) == 0)
+		return (EXIT_FAILURE);
+	if (rules.opts.serve != 0)
+		pl_serve(&rules);
+	else
+		pl_begin_simulation(&rules);
+	free(rules.cpus.order);
 	return (EXIT_SUCCESS);
 }
@@ -6,58 +6,28 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/24 16:39:39 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/03/01 14:25:02 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
-#include "philo_bonus.h"
-
-/**
- * @brief Kill all the philos at once
- * @param rules The rule struct
-*/
-void	pl_kill_philos(t_rules *rules, pid_t exclude)
-{
-	int	i;
 
-	i = -1;
-	while (++i < rules->philo_total)
-	{
-		if (exclude != -1 && rules->pids[i] == exclude)
-			continue ;
-		if (waitpid(rules->pids[i], NULL, WNOHANG) == 0)
-			kill(rules->pids[i], SIGTERM);
-	}
-}
+#include "philo_bonus.h"
 
 /**
- * @brief To check if all the philos are full
- * @param rules the simulation rules
- * 
- * @details
- * By default the full_sem is 0. When a philo is full, it will do a
- * sem_post to increment the value of semaphore by 1. Inside this function,
- * there's one while loop that will sem_wait for "philo_total" times.
- * As mentioned, initial value of full_sem is 0, and when we do a sem_wait
- * on a empty semaphore, it will wait until the value of semaphore is not
- * longer 0 then decrement the value by 1.
- * By following this logic, this is why the while loop will loop do sem_post
- * for "philo_total" times and able to check if all philos are full.
- * When all philos are full, sem_wait the declare sem. This is to prevent
- * any philo to declare their state.
- * Then, kill all philos!!!!!!
+ * @brief Arm the monitor's timer to go off at a point in time
+ * @param timer The timerfd
+ * @param when The time, on the monotonic clock like pl_now (ticks)
+ * @param flags TFD_TIMER_ABSTIME, or 0 for a time relative to now
 */
-void	pl_check_full(t_rules *rules)
+static void	pl_monitor_arm(int timer, t_tick when, int flags)
 {
-	int		i;
+	struct itimerspec	its;
 
-	i = -1;
-	if (rules->iteration == 0)
-		return ;
-	while (++i < rules->philo_total)
-		sem_wait(rules->locks.full_sem);
-	sem_wait(rules->locks.declare_sem);
-	exit(0);
+	its.it_interval.tv_sec = 0;
+	its.it_interval.tv_nsec = 0;
+	its.it_value.tv_sec = when / TICK_S;
+	its.it_value.tv_nsec = when % TICK_S;
+	timerfd_settime(timer, flags, &its, NULL);
 }
 
 /**
@@ -65,35 +35,75 @@ void	pl_check_full(t_rules *rules)
  * @param arg Assigned philo
  * 
  * @details
- * Check if the philo to starve to death. When that happens, declare
- * that the assigned philo is dead and sem_wait declare_sem to
- * prevent other philo to declare their state.
+ * The earliest the philo can starve is time_to_die after his last meal:
+ * sleep on the timerfd until then, and check. If he ate meanwhile, the
+ * deadline moved, sleep again. So a monitor wakes up about once per
+ * time_to_die, and doesn't wait on any other process: detecting a death
+ * costs the same at any table size.
+ * When he starved, declare that the assigned philo is dead. That halts
+ * the log, and only the first halt across every process wins (see
+ * pl_log_halt), so nothing other philos declare afterwards is printed.
+ * For a server (--serve), the monitor also stops once the run is over.
+ * The run is checked again once the timer is armed: a wake up from
+ * pl_monitor_wake before that would be overwritten.
  * 
  * @attention
  * Since this function will be executed by thread in the child process,
  * meaning if we call exit in thread, it will exit the child process
  * as well.
 */
-void	*pl_monitor(void *arg)
+static void	*pl_monitor(void *arg)
 {
-	t_philo			*philo;
-	int				timestamp;
+	t_philo		*philo;
+	t_tick		deadline;
+	uint64_t	expired;
 
 	philo = arg;
-	while (1)
+	while (pl_over(philo->rules) == 0)
 	{
-		sem_wait(philo->rules->locks.death_sem);
 		sem_wait(philo->last_ate_sem);
-		timestamp = pl_get_timestamp(philo->last_ate);
+		deadline = philo->last_ate + philo->rules->time_to_die * TICK_MS;
 		sem_post(philo->last_ate_sem);
-		if (timestamp > philo->rules->time_to_die)
+		if (pl_now() > deadline)
 		{
 			pl_declare_state(philo, DIED);
-			sem_wait(philo->rules->locks.declare_sem);
-			exit(0);
+			pl_philo_done(philo);
+			break ;
 		}
-		usleep(philo->rules->time_to_die / 2);
-		sem_post(philo->rules->locks.death_sem);
+		pl_monitor_arm(philo->timer, deadline + 1, TFD_TIMER_ABSTIME);
+		if (pl_over(philo->rules) || (read(philo->timer, &expired,
+					sizeof(expired)) < 0 && errno != EINTR))
+			break ;
 	}
 	return (NULL);
 }
+
+/**
+ * @brief Start the monitor thread of a philo
+ * @param philo The philo
+ * @param monitor Where to store the thread
+ * 
+ * @attention
+ * Shall call in the child: the timerfd is made there, once.
+ * 
+ * @return 1 if the monitor is running. 0 if there's an error.
+*/
+int	pl_monitor_start(t_philo *philo, pthread_t *monitor)
+{
+	if (philo->timer < 0)
+		philo->timer = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	if (philo->timer < 0
+		|| pthread_create(monitor, NULL, &pl_monitor, philo) != 0)
+		return (pl_show_error(CREATE_THD_FAILED, philo->id));
+	pl_rt_boost(philo->rules, *monitor);
+	return (1);
+}
+
+/**
+ * @brief Wake the monitor up now, so that it sees the run is over
+ * @param philo The philo
+*/
+void	pl_monitor_wake(t_philo *philo)
+{
+	pl_monitor_arm(philo->timer, 1, 0);
+}
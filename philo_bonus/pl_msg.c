@@ -6,12 +6,33 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/24 11:12:39 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/03/01 14:08:08 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 23:18:04 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo_bonus.h"
 
+/**
+ * @brief Show the message of an error the system caused
+ * @param error Error type (OPEN_SEM_FAILED and after)
+ * @param id The id of the philo
+*/
+static void	pl_show_sys_error(t_error error, int id)
+{
+	if (error == CREATE_THD_FAILED)
+		printf("Failed to create PHILO %d\n", id);
+	else if (error == OPEN_SEM_FAILED)
+		printf("Failed to open SEMAPHORE\n");
+	else if (error == MMAP_FAILED)
+		printf("Failed to map SHARED MEMORY\n");
+	else if (error == FORK_FAILED)
+		printf("Failed to FORK child!\n");
+	else if (error == REACTOR_FAILED)
+		printf("Failed to set up the REACTOR\n");
+	else if (error == BARRIER_FAILED)
+		printf("Failed to set up the START LINE\n");
+}
+
 /**
  * @brief Show error message
  * @param error Error type
@@ -34,12 +55,12 @@ int	pl_show_error(t_error error, int id)
 		printf("Found Negative numeric argument!\n\n");
 	else if (error == INVALID_OPTION)
 		printf("Optional argument should more than 0!\n\n");
-	else if (error == CREATE_THD_FAILED)
-		printf("Failed to create PHILO %d\n", id);
-	else if (error == OPEN_SEM_FAILED)
-		printf("Failed to open SEMAPHORE\n");
-	else if (error == FORK_FAILED)
-		printf("Failed to FORK child!\n");
+	else if (error == INVALID_FLAG)
+		printf("Unknown option, or its value is invalid!\n\n");
+	else if (error == TOO_MANY_PHILOS)
+		printf("Need 1 philo, and no more than --serve keeps warm!\n\n");
+	else
+		pl_show_sys_error(error, id);
 	if (!(error >= CREATE_THD_FAILED && error < ERROR_TOTAL))
 		printf(GRN"Run `make help` for help.\n"DEF);
 	return (0);
@@ -51,29 +72,17 @@ int	pl_show_error(t_error error, int id)
  * @param state The state of the philo
  * 
  * @details
- * Process of declaring a philo's state is protected by a
- * semaphore to prevent every philo to declare their state
- * at the same time. This means there will only be only
- * philo to declare state every single time.
+ * Nothing is printed here: the event goes into the philo's ring in shared
+ * memory and the parent prints it. No semaphore is involved. A death
+ * halts the log, so it's the last line no matter which process logs
+ * after it.
 */
 void	pl_declare_state(t_philo *philo, t_state state)
 {
-	struct timeval	start_time;
-
 	if (philo == NULL)
 		return ;
-	sem_wait(philo->rules->locks.declare_sem);
-	start_time = philo->rules->start_time;
-	printf(WHT"%8d %3d ", pl_get_timestamp(start_time), philo->id + 1);
-	if (state == FORK)
-		printf(PUR"has taken a fork\n"DEF);
-	else if (state == EAT)
-		printf(GRN"is eating\n"DEF);
-	else if (state == SLEEP)
-		printf(CYN"is sleeping\n"DEF);
-	else if (state == THINK)
-		printf(YLW"is thinking\n"DEF);
-	else if (state == DIED)
-		printf(RED"%s\n"DEF, "died");
-	sem_post(philo->rules->locks.declare_sem);
+	if (state == DIED)
+		pl_log_halt(philo->rules->log, philo->id, DIED);
+	else
+		pl_log_push(philo->rules->log, philo->id, state);
 }
@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_option.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:17:17 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Match an option against its name
+ * @param arg The argument, e.g. "--spin=50"
+ * @param name The option's name, e.g. "--spin"
+ * 
+ * @return The value after "<name>=", NULL if arg is not that option.
+*/
+char	*pl_opt_value(char *arg, char *name)
+{
+	while (*name != '\0' && *arg == *name)
+	{
+		arg++;
+		name++;
+	}
+	if (*name != '\0' || *arg != '=')
+		return (NULL);
+	return (arg + 1);
+}
+
+/**
+ * @brief Read the unsigned number of an option
+ * @param value The value of the option
+ * @param max The biggest value allowed
+ * @param num Where to store the number
+ * 
+ * @return 1 on success, 0 if value is not a number or is bigger than max.
+*/
+static int	pl_opt_number(char *value, long max, long *num)
+{
+	*num = 0;
+	if (*value == '\0')
+		return (0);
+	while (*value >= '0' && *value <= '9')
+	{
+		*num = *num * 10 + (*value++ - '0');
+		if (*num > max)
+			return (0);
+	}
+	return (*value == '\0');
+}
+
+/**
+ * @brief Parse a single option
+ * @param arg The argument
+ * @param opts The options struct
+ * 
+ * @return 1 if the option is known and its value valid, 0 otherwise.
+*/
+static int	pl_parse_option(char *arg, t_options *opts)
+{
+	char	*value;
+	long	num;
+	int		ret;
+
+	value = pl_opt_value(arg, "--spin");
+	if (value != NULL)
+	{
+		if (pl_opt_number(value, 1000000, &num) == 0)
+			return (0);
+		opts->spin = num * TICK_US;
+		return (1);
+	}
+	value = pl_opt_value(arg, "--serve");
+	if (value != NULL)
+	{
+		if (pl_opt_number(value, SERVE_MAX, &num) == 0 || num == 0)
+			return (0);
+		opts->serve = num;
+		return (1);
+	}
+	ret = pl_parse_rt(arg, opts);
+	if (ret != -1)
+		return (ret);
+	return (pl_parse_choice(arg, opts));
+}
+
+/**
+ * @brief Parse the options that come after the arguments
+ * @param ac Option count
+ * @param av Options
+ * @param opts The options struct
+ * 
+ * @details
+ * Options look like `--name=value`, or just `--name` for switches.
+ * Anything not given keeps its default:
+ * --spin=0			Sleep all the way to a wake up, no yielding
+ * --format=text	Aligned columns with colours
+ * --serve=0		Run once, don't serve rule lines from stdin
+ * --sem=named		Semaphores opened by name in /dev/shm
+ * --fork=pool		Any two forks of the pool will do
+ * --affinity=none	Philos go where the scheduler puts them
+ * --rt, --mlock	Off: normal scheduling, pages may be swapped out
+ * 
+ * @return Return 1 if every option is valid, 0 otherwise.
+*/
+int	pl_parse_options(int ac, char **av, t_options *opts)
+{
+	opts->spin = 0;
+	opts->format = TEXT;
+	opts->serve = 0;
+	opts->sem = NAMED;
+	opts->fork = POOL;
+	opts->pin = PIN_NONE;
+	opts->rt_policy = SCHED_OTHER;
+	opts->rt_prio = 0;
+	opts->mlock = 0;
+	while (ac-- > 0)
+	{
+		if (pl_parse_option(*av++, opts) == 0)
+			return (pl_show_error(INVALID_FLAG, 0));
+	}
+	return (1);
+}
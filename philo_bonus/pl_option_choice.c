@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_option_choice.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:29:57 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Find a value among the ones an option accepts
+ * @param value The value given
+ * @param choices The accepted values, separated by spaces
+ * 
+ * @return Its index among the choices, -1 if it's not one of them.
+*/
+static int	pl_opt_choice(char *value, char *choices)
+{
+	int	index;
+	int	len;
+
+	index = 0;
+	while (*choices != '\0')
+	{
+		len = 0;
+		while (choices[len] != '\0' && choices[len] != ' ')
+			len++;
+		if (strncmp(value, choices, len) == 0 && value[len] == '\0')
+			return (index);
+		choices += len;
+		if (*choices == ' ')
+			choices++;
+		index++;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Parse an option that takes one of a few names
+ * @param arg The argument
+ * @param opts The options struct
+ * 
+ * @return 1 if the option is known and its value valid, 0 otherwise.
+*/
+int	pl_parse_choice(char *arg, t_options *opts)
+{
+	char	*value;
+	int		choice;
+
+	choice = -1;
+	value = pl_opt_value(arg, "--format");
+	if (value != NULL)
+		choice = pl_opt_choice(value, "text plain csv bin");
+	if (choice >= 0)
+		opts->format = choice;
+	value = pl_opt_value(arg, "--sem");
+	if (value != NULL)
+		choice = pl_opt_choice(value, "named anon");
+	if (value != NULL && choice >= 0)
+		opts->sem = choice;
+	value = pl_opt_value(arg, "--fork");
+	if (value != NULL)
+		choice = pl_opt_choice(value, "pool adjacent");
+	if (value != NULL && choice >= 0)
+		opts->fork = choice;
+	return (choice >= 0);
+}
+
+/**
+ * @brief Read a real-time policy and its priority
+ * @param value "fifo" or "rr", then maybe ":<prio>"
+ * @param opts The options struct
+ * 
+ * @return 1 if the priority is between 1 and 99 (RT_PRIO if none),
+ *         0 otherwise.
+*/
+static int	pl_opt_policy(char *value, t_options *opts)
+{
+	opts->rt_prio = RT_PRIO;
+	opts->rt_policy = SCHED_RR;
+	if (strncmp(value, "fifo", 4) == 0)
+		opts->rt_policy = SCHED_FIFO;
+	if (opts->rt_policy == SCHED_FIFO)
+		value += 4;
+	else if (strncmp(value, "rr", 2) == 0)
+		value += 2;
+	else
+		return (0);
+	if (*value == '\0')
+		return (1);
+	if (*value++ != ':' || *value == '\0')
+		return (0);
+	opts->rt_prio = 0;
+	while (*value >= '0' && *value <= '9' && opts->rt_prio < 100)
+		opts->rt_prio = opts->rt_prio * 10 + (*value++ - '0');
+	return (*value == '\0' && opts->rt_prio >= 1 && opts->rt_prio <= 99);
+}
+
+/**
+ * @brief Parse the options that place the threads on the CPUs
+ * @param arg The argument
+ * @param opts The options struct
+ * 
+ * @details
+ * --affinity=none|rr|numa	Pin every philo to a CPU, see pl_rt_child
+ * --rt=fifo|rr[:<prio>]	SCHED_FIFO or SCHED_RR, the monitor one above
+ * --mlock					Lock every page, now and to come, in memory
+ * 
+ * @return -1 if arg is not one of them, 1 if its value is valid, 0 if not.
+*/
+int	pl_parse_rt(char *arg, t_options *opts)
+{
+	char	*value;
+	int		choice;
+
+	if (strcmp(arg, "--mlock") == 0)
+	{
+		opts->mlock = 1;
+		return (1);
+	}
+	value = pl_opt_value(arg, "--affinity");
+	if (value != NULL)
+	{
+		choice = pl_opt_choice(value, "none rr numa");
+		if (choice >= 0)
+			opts->pin = choice;
+		return (choice >= 0);
+	}
+	value = pl_opt_value(arg, "--rt");
+	if (value == NULL)
+		return (-1);
+	return (pl_opt_policy(value, opts));
+}
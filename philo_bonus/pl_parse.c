@@ -6,7 +6,7 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/24 11:08:38 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/02/25 16:38:58 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 22:50:44 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -104,21 +104,30 @@ static int	pl_check_args(int ac, char **av)
 }
 
 /**
- * @brief Set up simulation rules
- * @param ac Argument count (not including program name)
- * @param av Arguments (not including program name)
+ * @brief Check the arguments and store them into rules struct
+ * @param ac Argument count, options excluded
+ * @param av Arguments
  * @param rules The rules struct
+ *
+ * @details
+ * Also used by a server (--serve) on every rule line it reads.
+ *
+ * @return Return 1 if the arguments are valid, 0 otherwise.
  */
-static void	pl_setup_rules(int ac, char **av, t_rules *rules)
+int	pl_parse_rules(int ac, char **av, t_rules *rules)
 {
+	if (ac != 4 && ac != 5)
+		return (pl_show_error(INVALID_ARGS_TOTAL, 0));
+	if (pl_check_args(ac, av) == 0)
+		return (0);
 	rules->philo_total = ft_atoi(*av++);
 	rules->time_to_die = ft_atoi(*av++);
 	rules->time_to_eat = ft_atoi(*av++);
 	rules->time_to_sleep = ft_atoi(*av++);
+	rules->iteration = 0;
 	if (ac == 5)
 		rules->iteration = ft_atoi(*av);
-	else
-		rules->iteration = 0;
+	return (1);
 }
 
 /**
@@ -128,19 +137,26 @@ static void	pl_setup_rules(int ac, char **av, t_rules *rules)
  * @param rules The rules struct
  *
  * @details
- * 1. Initialize the rules struct
- * 2. If the ac is not 4 nor 5, show error and return
- * 3. Check args
- * 4. Set simulation info
+ * 1. Count the arguments, options (`--name=value`) come after them
+ * 2. Parse the options
+ * 3. A server (--serve) reads its rules from stdin, the arguments are
+ *    optional and only make its first run
+ * 4. Check args and set simulation info
  *
  * @return Return 1 if the parse process is successful, 0 otherwise.
  */
 int	pl_parse(int ac, char **av, t_rules *rules)
 {
-	if (ac != 4 && ac != 5)
-		return (pl_show_error(INVALID_ARGS_TOTAL, 0));
-	if (pl_check_args(ac, av) == 0)
+	int	argc;
+
+	argc = 0;
+	while (argc < ac && (av[argc][0] != '-' || av[argc][1] != '-'))
+		argc++;
+	if (pl_parse_options(ac - argc, av + argc, &rules->opts) == 0)
 		return (0);
-	pl_setup_rules(ac, av, rules);
-	return (1);
+	rules->board = NULL;
+	rules->philo_total = 0;
+	if (rules->opts.serve != 0 && argc == 0)
+		return (1);
+	return (pl_parse_rules(argc, av, rules));
 }
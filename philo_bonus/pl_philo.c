@@ -6,7 +6,7 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/24 11:17:36 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/03/01 14:09:05 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 23:18:04 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -23,7 +23,8 @@ int	pl_philo_init(t_simulation *sim, t_philo *philo, int id)
 	philo->id = id;
 	philo->meal_count = 0;
 	philo->full = NOTFULL;
-	gettimeofday(&philo->last_ate, NULL);
+	philo->timer = -1;
+	philo->last_ate = pl_now();
 	philo->rules = sim->rules;
 	if (pl_setup_philo_sem(philo) == 0)
 		return (0);
@@ -33,7 +34,8 @@ int	pl_philo_init(t_simulation *sim, t_philo *philo, int id)
 /**
  * @brief Spawn philo. Create process for each philo. Spawn one monitor to
  * 	      each philo as well. The monitor thread will be detached, run in
- *        background.
+ *        background. Every philo joins the same process group, so that
+ *        they can all be killed at once.
  * @param sim The simulation struct
  *
  * @return 1 if all the philo can be initialized and philos are running.
@@ -61,10 +63,13 @@ int	pl_spawn_philo(t_simulation *sim)
 			return (pl_show_error(FORK_FAILED, -1));
 		if (pid == 0)
 		{
+			setpgid(0, sim->rules->reactor.pgid);
+			pl_rt_child(&philos[i], sim->rules->philo_total);
+			pl_start_wait(&philos[i]);
 			pl_routine(&philos[i]);
 			break ;
 		}
-		sim->rules->pids[i] = pid;
+		pl_reactor_adopt(&sim->rules->reactor, pid);
 	}
 	return (1);
 }
@@ -75,29 +80,38 @@ int	pl_spawn_philo(t_simulation *sim)
  * @param rules The rules struct
  * 
  * 1. Set rules
- * 2. Open semaphore for the forks
- * 3. Malloc an array for pids (store pid of child)
- * 4. Get start time
- * 5. Set shared semaphores
- * 6. Spawn philo
- * 7. Check if the philo is full (if option is enabled)
+ * 2. Map the semaphores (--sem=anon), open the one for the forks
+ * 3. Set up the reactor (before any child exists)
+ * 4. Map the logger in shared memory, with the start line
+ * 5. Spawn philo, each waits at the start line (killed if a spawn fails)
+ * 6. Start the log writer
+ * 7. Get start time, and let every philo go
 */
 int	pl_simulation_init(t_simulation *sim, t_rules *rules)
 {
 	sim->rules = rules;
-	if (pl_sem_open(&rules->forks, FORK_SEM, rules->philo_total) == 0)
+	if (pl_sem_init(rules, rules->philo_total) == 0
+		|| pl_sem_open(rules, &rules->forks, FORK_SEM,
+			rules->philo_total) == 0
+		|| pl_sem_open(rules, &rules->gate, GATE_SEM, 1) == 0)
 		return (0);
 	sim->philos = malloc(sizeof(t_philo) * rules->philo_total);
 	if (sim->philos == NULL)
 		return (0);
-	rules->pids = malloc(sizeof(pid_t) * rules->philo_total);
-	if (rules->pids == NULL)
+	if (pl_table_init(rules, rules->philo_total) == 0)
 		return (0);
-	if (pl_setup_shared_sem(&rules->locks) == 0)
+	if (pl_reactor_init(&rules->reactor, 0) == 0)
 		return (0);
-	gettimeofday(&rules->start_time, NULL);
-	if (pl_spawn_philo(sim) == 0)
+	if (pl_log_init(&rules->log, rules->philo_total, pl_now(),
+			rules->opts.format) == 0 || pl_start_init(rules) == 0)
 		return (0);
+	if (pl_spawn_philo(sim) == 0 || pl_log_start(rules->log) == 0)
+	{
+		if (rules->reactor.pgid > 0)
+			killpg(rules->reactor.pgid, SIGKILL);
+		return (0);
+	}
+	pl_start_release(rules);
 	return (1);
 }
 
@@ -105,46 +119,20 @@ int	pl_simulation_init(t_simulation *sim, t_rules *rules)
  * @brief Function to end the simulation when someone is dead or
  *        everyone is full.
  * 
- * @attention
- * waitpid returns the process ID of the child whose state has
- * changed.
- * 
  * @details
- * The idea here is to use the return value of waitpid to know
- * the reason why the simulation end. If the "exited" value is
- * the same as "check_full", meaning all philo are full. If the
- * "exited" value is not the same as "check_full", meaning someone
- * died.
- * 
- * If the reason is because all philo are full, kill all the philos.
- * If the reason is because someone died, kill all the philos but
- * excluding that one that has already exited.
- * 
- * @credit to MTLKS for such an elegant way to check if any philo exits :D
+ * The parent sleeps in its reactor until the first child exits: the one
+ * that died, or the last one to get full. Both halted the log already.
+ * Then the whole process group is killed at once and reaped, and the log
+ * writer flushes what's left.
 */
 void	pl_end_simulation(t_rules *rules)
 {
-	pid_t	check_full;
-	pid_t	exited;
-
-	exited = -1;
-	check_full = fork();
-	if (check_full == 0)
-		pl_check_full(rules);
-	while (exited == -1)
-		exited = waitpid(-1, NULL, 0);
-	if (exited == check_full)
-		pl_kill_philos(rules, -1);
-	else if (exited > 0)
-	{
-		kill(check_full, SIGTERM);
-		pl_kill_philos(rules, exited);
-	}
-	sem_close(rules->locks.declare_sem);
-	sem_close(rules->locks.full_sem);
-	sem_close(rules->locks.sim_sem);
-	sem_close(rules->locks.death_sem);
-	free(rules->pids);
+	pl_reactor_wait(&rules->reactor);
+	pl_reactor_stop(&rules->reactor, rules->philo_total);
+	pl_log_stop(rules->log);
+	pthread_barrier_destroy(&rules->log->start_line);
+	munmap(rules->log, rules->log->size);
+	pl_sem_release(rules);
 }
 
 /**
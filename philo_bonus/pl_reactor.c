@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_reactor.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:40:54 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:50:44 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Have the reactor watch a file descriptor
+ * @param reactor The reactor
+ * @param fd The file descriptor, watched for reading
+ * 
+ * @return 1 on success, 0 on error.
+*/
+static int	pl_reactor_watch(t_reactor *reactor, int fd)
+{
+	struct epoll_event	ev;
+
+	ev.events = EPOLLIN;
+	ev.data.fd = fd;
+	return (fd >= 0
+		&& epoll_ctl(reactor->epfd, EPOLL_CTL_ADD, fd, &ev) == 0);
+}
+
+/**
+ * @brief Set up the parent's reactor
+ * @param reactor The reactor
+ * @param events Also watch an eventfd the philos write to when a run is
+ *               over (server mode), instead of exiting
+ * 
+ * @details
+ * SIGCHLD is blocked and read from a signalfd instead, watched by epoll.
+ * It's blocked before any child is forked, so an early exit can't be
+ * missed.
+ * 
+ * @return 1 on success, 0 on error.
+*/
+int	pl_reactor_init(t_reactor *reactor, int events)
+{
+	sigset_t	mask;
+
+	reactor->pgid = 0;
+	reactor->evfd = -1;
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGCHLD);
+	if (sigprocmask(SIG_BLOCK, &mask, NULL) != 0)
+		return (pl_show_error(REACTOR_FAILED, -1));
+	reactor->sigfd = signalfd(-1, &mask, SFD_CLOEXEC);
+	reactor->epfd = epoll_create1(EPOLL_CLOEXEC);
+	if (reactor->epfd < 0 || pl_reactor_watch(reactor, reactor->sigfd) == 0)
+		return (pl_show_error(REACTOR_FAILED, -1));
+	if (events == 0)
+		return (1);
+	reactor->evfd = eventfd(0, EFD_NONBLOCK);
+	if (pl_reactor_watch(reactor, reactor->evfd) == 0)
+		return (pl_show_error(REACTOR_FAILED, -1));
+	return (1);
+}
+
+/**
+ * @brief Put a child in the process group of the philos (parent side)
+ * @param reactor The reactor
+ * @param pid The child
+ * 
+ * @details
+ * The first child leads the group. The child does the same on its side
+ * (setpgid(0, pgid)), whoever runs first wins, so the group is right
+ * before either of them goes on.
+*/
+void	pl_reactor_adopt(t_reactor *reactor, pid_t pid)
+{
+	setpgid(pid, reactor->pgid);
+	if (reactor->pgid == 0)
+		reactor->pgid = pid;
+}
+
+/**
+ * @brief Sleep until a child exits, or a run is over (server mode)
+ * @param reactor The reactor
+ * 
+ * @details
+ * A child only exits once the simulation is over: it died, or it was
+ * the last one to get full. Either way it halted the log before exiting,
+ * so there's nothing to tell apart here. A server's philos write to the
+ * eventfd instead, a child exiting there means something went wrong.
+ * An eventfd that can't be read is taken the same way, as the run's end
+ * can't be told anymore. A signalfd that can't be read is reported, the
+ * simulation ends all the same.
+ * 
+ * @return 1 if a run is over, 0 if a child exited (or the eventfd
+ *         failed).
+*/
+int	pl_reactor_wait(t_reactor *reactor)
+{
+	struct epoll_event		ev;
+	struct signalfd_siginfo	info;
+	uint64_t				count;
+	int						ready;
+
+	ready = 0;
+	while (ready != 1)
+		ready = epoll_wait(reactor->epfd, &ev, 1, -1);
+	if (ev.data.fd == reactor->evfd)
+		return (read(reactor->evfd, &count, sizeof(count))
+			== sizeof(count));
+	if (read(reactor->sigfd, &info, sizeof(info)) != sizeof(info))
+		pl_show_error(REACTOR_FAILED, -1);
+	return (0);
+}
+
+/**
+ * @brief Kill every child at once and reap them
+ * @param reactor The reactor
+ * @param total Number of children
+ * 
+ * @details
+ * A single kill for the whole group, so every child is gone within the
+ * same scheduling round whatever the size of the table. The children are
+ * reaped after, so that nothing is still writing to the log when it's
+ * flushed for the last time.
+*/
+void	pl_reactor_stop(t_reactor *reactor, int total)
+{
+	if (reactor->pgid > 0)
+		killpg(reactor->pgid, SIGKILL);
+	while (total-- > 0)
+		waitpid(-reactor->pgid, NULL, 0);
+	close(reactor->sigfd);
+	close(reactor->epfd);
+	if (reactor->evfd >= 0)
+		close(reactor->evfd);
+}
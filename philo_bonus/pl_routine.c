@@ -6,7 +6,7 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/24 14:59:58 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/03/01 14:32:12 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 22:56:14 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -20,15 +20,27 @@
  * @details
  * If act is "TAKE", sem_wait. (Take fork)
  * If act is "RETURN", sem_post. (Return fork)
+ * Both forks are taken behind the gate: a philo waiting for his second
+ * fork holds it, so the next fork put down goes to him rather than to
+ * someone who'd hold it while waiting for another. Had everyone grabbed
+ * one fork on the same tick, the table would starve.
+ * With --fork=adjacent, both of the philo's own forks are taken at once
+ * from the table instead.
 */
 void	pl_fork_action(t_philo *philo, t_fork_action act)
 {
-	if (act == TAKE)
+	if (philo->rules->table != NULL && act == TAKE)
+		pl_table_take(philo);
+	else if (philo->rules->table != NULL && act == RETURN)
+		pl_table_put(philo);
+	else if (act == TAKE)
 	{
+		sem_wait(philo->rules->gate);
 		sem_wait(philo->rules->forks);
 		pl_declare_state(philo, FORK);
 		sem_wait(philo->rules->forks);
 		pl_declare_state(philo, FORK);
+		sem_post(philo->rules->gate);
 	}
 	else if (act == RETURN)
 	{
@@ -47,32 +59,81 @@ void	pl_fork_action(t_philo *philo, t_fork_action act)
  * 2. Update last_ate time before eating (need to protect)
  * 3. Declare EAT as the assigned philo's state
  * 4. Update the meal count; (need to protect)
- * 5. Check if the phil is full, if yes, sem_post full_sem
- * 6. Put down forks (Left & Right)
+ * 5. Count the philo as full in shared memory once he's had enough. The
+ *    last one to get full halts the log and is done, which ends the
+ *    simulation (see pl_reactor_wait)
+ * 6. Eat until "time_to_eat" after the meal started
+ * 7. Put down forks (Left & Right)
+ * 
+ * A server ends a run by handing out spare forks, a philo that gets his
+ * forks that way puts them back without eating.
+ * 
+ * @return The time the meal ended
 */
-void	pl_eat(t_philo *philo)
+t_tick	pl_eat(t_philo *philo)
 {
+	t_tick	done;
+
 	pl_fork_action(philo, TAKE);
+	done = pl_now();
+	if (pl_over(philo->rules))
+	{
+		pl_fork_action(philo, RETURN);
+		return (done);
+	}
 	sem_wait(philo->last_ate_sem);
-	gettimeofday(&philo->last_ate, NULL);
+	philo->last_ate = done;
 	sem_post(philo->last_ate_sem);
+	done += philo->rules->time_to_eat * TICK_MS;
 	pl_declare_state(philo, EAT);
 	philo->meal_count++;
-	if (philo->meal_count == philo->rules->iteration)
-		sem_post(philo->rules->locks.full_sem);
-	pl_usleep(philo->rules->time_to_eat);
+	if (philo->meal_count == philo->rules->iteration
+		&& atomic_fetch_add(&philo->rules->log->full, 1) + 1
+		== philo->rules->philo_total)
+	{
+		pl_log_halt(philo->rules->log, philo->id, FULL);
+		pl_philo_done(philo);
+	}
+	pl_nap(philo, done);
 	pl_fork_action(philo, RETURN);
+	return (done);
 }
 
 /**
  * @brief Sleep routine of philo
+ * @param philo The assigned philo
+ * @param from The time the meal ended
  * 
- * Declare state and sleep for "time_to_sleep"
+ * Declare state and sleep until "time_to_sleep" after the meal. Counting
+ * from the end of the meal rather than from now keeps a late wake up from
+ * adding up over the iterations.
 */
-void	pl_sleep(t_philo *philo)
+void	pl_sleep(t_philo *philo, t_tick from)
 {
 	pl_declare_state(philo, SLEEP);
-	pl_usleep(philo->rules->time_to_sleep);
+	pl_nap(philo, from + philo->rules->time_to_sleep * TICK_MS);
+}
+
+/**
+ * @brief Eat, sleep and think until the simulation is over
+ * @param philo The assigned philo
+ * 
+ * @details
+ * Only a server (--serve) ever calls a simulation over, otherwise the
+ * philo dines until he's killed or exits. Every philo leaves the start
+ * line on the same tick, odd ones first wait for half a meal (see
+ * pl_routine), as philo does.
+*/
+void	pl_dine(t_philo *philo)
+{
+	if (philo->id % 2 != 0)
+		pl_nap(philo, philo->rules->start_time
+			+ philo->rules->time_to_eat * TICK_MS / 2);
+	while (pl_over(philo->rules) == 0)
+	{
+		pl_sleep(philo, pl_eat(philo));
+		pl_declare_state(philo, THINK);
+	}
 }
 
 /**
@@ -86,7 +147,7 @@ void	pl_sleep(t_philo *philo)
  * Since when one philo needs to eat, he needs to take the fork
  * of his and the one sitting next to him. So, the idea here is
  * to seperate the philosophers into two big group. If the 
- * ID of the philo is odd number, they have to wait for
+ * ID of the philo is odd number, they have to wait for half of
  * "time_to_eat" time. Else, they can perform the routine first.
  * 
  * Routine:
@@ -102,16 +163,8 @@ void	pl_routine(t_philo *philo)
 {
 	pthread_t	monitor;
 
-	if (pthread_create(&monitor, NULL, &pl_monitor, (void *)philo) != 0)
-	{
-		pl_show_error(CREATE_THD_FAILED, philo->id);
+	if (pl_monitor_start(philo, &monitor) == 0)
 		return ;
-	}
 	pthread_detach(monitor);
-	while (1)
-	{
-		pl_eat(philo);
-		pl_sleep(philo);
-		pl_declare_state(philo, THINK);
-	}
+	pl_dine(philo);
 }
@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_rt.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:04:19 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:04:19 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Say on stderr that a real-time option can't be honoured
+ * @param what The option
+ * @param err The error it failed with
+*/
+static void	pl_rt_warn(char *what, int err)
+{
+	fprintf(stderr, "warning: %s: %s, going on without it\n", what,
+		strerror(err));
+}
+
+/**
+ * @brief Lock memory, switch to a real-time policy and list the CPUs to
+ *        pin to, as the options ask
+ * @param rules The simulation rules
+ * 
+ * @details
+ * The policy is set on the parent: the children forked after inherit it,
+ * and so do their monitors. Real-time scheduling and locking memory need
+ * privileges (CAP_SYS_NICE, CAP_IPC_LOCK or rlimits), without them the
+ * simulation still runs, after a warning.
+ * 
+ * @attention
+ * Shall call in parent before forking.
+ * 
+ * @return 1 on success, 0 on error.
+*/
+int	pl_rt_init(t_rules *rules)
+{
+	struct sched_param	param;
+	int					err;
+
+	if (rules->opts.mlock && mlockall(RT_MLOCK) != 0)
+	{
+		pl_rt_warn("--mlock", errno);
+		rules->opts.mlock = 0;
+	}
+	if (rules->opts.rt_policy != SCHED_OTHER)
+	{
+		param.sched_priority = rules->opts.rt_prio;
+		err = pthread_setschedparam(pthread_self(), rules->opts.rt_policy,
+				&param);
+		if (err != 0)
+		{
+			pl_rt_warn("--rt", err);
+			rules->opts.rt_policy = SCHED_OTHER;
+		}
+	}
+	return (pl_rt_cpus(rules));
+}
+
+/**
+ * @brief Pin a freshly forked philo to his CPU (--affinity), and lock his
+ *        memory again (--mlock)
+ * @param philo The philo
+ * @param slots Number of philos forked
+ * 
+ * @details
+ * rr deals the CPUs out one after the other, wrapping around. numa cuts
+ * the philos into as many contiguous blocks as there are CPUs: neighbours
+ * share a CPU, or one of the same node, as long as there are few CPUs
+ * per philo. Memory locks aren't inherited across fork, the child takes
+ * its own.
+ * 
+ * @attention
+ * Shall call in the child, before its monitor is started.
+*/
+void	pl_rt_child(t_philo *philo, int slots)
+{
+	t_rules		*rules;
+	cpu_set_t	set;
+	int			index;
+
+	rules = philo->rules;
+	if (rules->opts.mlock)
+		mlockall(RT_MLOCK);
+	if (rules->cpus.total == 0)
+		return ;
+	index = philo->id % rules->cpus.total;
+	if (rules->opts.pin == PIN_NUMA)
+		index = (long)philo->id * rules->cpus.total / slots;
+	CPU_ZERO(&set);
+	CPU_SET(rules->cpus.order[index], &set);
+	sched_setaffinity(0, sizeof(set), &set);
+}
+
+/**
+ * @brief Give a monitor a priority above his philo (--rt), so that a
+ *        death is seen even while the philo is busy
+ * @param rules The simulation rules
+ * @param thread The monitor thread
+*/
+void	pl_rt_boost(t_rules *rules, pthread_t thread)
+{
+	struct sched_param	param;
+
+	if (rules->opts.rt_policy == SCHED_OTHER)
+		return ;
+	param.sched_priority = rules->opts.rt_prio + 1;
+	if (param.sched_priority > 99)
+		param.sched_priority = 99;
+	pthread_setschedparam(thread, rules->opts.rt_policy, &param);
+}
@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_rt_cpus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:03:14 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:03:14 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Read a CPU number of a cpulist
+ * @param list The cpulist, moved past the number
+ * 
+ * @return The number.
+*/
+static int	pl_cpus_number(char **list)
+{
+	int	num;
+
+	num = 0;
+	while (**list >= '0' && **list <= '9')
+		num = num * 10 + (*(*list)++ - '0');
+	return (num);
+}
+
+/**
+ * @brief Add the CPUs of a cpulist ("0-3,8-11") that are allowed
+ * @param list The cpulist
+ * @param allowed The CPUs the process may run on, the ones added are
+ *        taken out so that none is added twice
+ * @param cpus Where to add them
+*/
+static void	pl_cpus_list(char *list, cpu_set_t *allowed, t_cpus *cpus)
+{
+	int	first;
+	int	last;
+
+	while (*list >= '0' && *list <= '9')
+	{
+		first = pl_cpus_number(&list);
+		last = first;
+		if (*list == '-' && list++)
+			last = pl_cpus_number(&list);
+		while (first <= last && first < CPU_SETSIZE)
+		{
+			if (CPU_ISSET(first, allowed))
+				cpus->order[cpus->total++] = first;
+			CPU_CLR(first, allowed);
+			first++;
+		}
+		if (*list == ',')
+			list++;
+	}
+}
+
+/**
+ * @brief Add the allowed CPUs of a NUMA node
+ * @param node The node
+ * @param allowed The CPUs the process may run on
+ * @param cpus Where to add them, nothing if there's no such node
+*/
+static void	pl_cpus_node(int node, cpu_set_t *allowed, t_cpus *cpus)
+{
+	char	path[64];
+	char	list[4096];
+	ssize_t	len;
+	int		fd;
+
+	snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+		node);
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return ;
+	len = read(fd, list, sizeof(list) - 1);
+	close(fd);
+	if (len < 0)
+		len = 0;
+	list[len] = '\0';
+	pl_cpus_list(list, allowed, cpus);
+}
+
+/**
+ * @brief List the CPUs philos get pinned to (--affinity)
+ * @param rules The simulation rules
+ * 
+ * @details
+ * Only the CPUs the process is allowed on (taskset, cgroups) are listed.
+ * With --affinity=numa they come node by node, so that CPUs next to each
+ * other in the list share a node. Nodes are looked up in sysfs, a CPU on
+ * none of them (no sysfs, no NUMA) goes last, in the order of rr.
+ * 
+ * @return 1 on success, 0 if the list can't be made.
+*/
+int	pl_rt_cpus(t_rules *rules)
+{
+	cpu_set_t	allowed;
+	int			cpu;
+	int			node;
+
+	rules->cpus.order = NULL;
+	rules->cpus.total = 0;
+	if (rules->opts.pin == PIN_NONE)
+		return (1);
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+		return (0);
+	rules->cpus.order = malloc(sizeof(int) * CPU_COUNT(&allowed));
+	if (rules->cpus.order == NULL)
+		return (0);
+	node = -1;
+	while (rules->opts.pin == PIN_NUMA && ++node < RT_NODE_MAX)
+		pl_cpus_node(node, &allowed, &rules->cpus);
+	cpu = -1;
+	while (++cpu < CPU_SETSIZE)
+	{
+		if (CPU_ISSET(cpu, &allowed))
+			rules->cpus.order[rules->cpus.total++] = cpu;
+	}
+	return (1);
+}
@@ -6,14 +6,49 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/24 11:29:12 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/02/27 16:45:41 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 22:56:14 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo_bonus.h"
 
+/**
+ * @brief Map the unnamed semaphores, if they're used (--sem=anon)
+ * @param rules The rules struct
+ * @param philo_total Number of philos that will be forked
+ * 
+ * @details
+ * One mapping holds the forks, the gate and one LAST_ATE per
+ * philo. Nothing goes through /dev/shm: setting up costs one mmap, a
+ * crash leaves no name behind, and runs next to each other can't open
+ * each other's semaphores.
+ * 
+ * @attention
+ * Shall call in parent before any pl_sem_open and before forking.
+ * 
+ * @return 1 on success, 0 on error.
+*/
+int	pl_sem_init(t_rules *rules, int philo_total)
+{
+	t_sem_pool	*pool;
+
+	pool = &rules->sems;
+	pool->used = 0;
+	pool->total = 0;
+	if (rules->opts.sem != ANON)
+		return (1);
+	pool->total = philo_total + 2;
+	pool->size = sizeof(sem_t) * pool->total;
+	pool->slots = mmap(NULL, pool->size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (pool->slots == MAP_FAILED)
+		return (pl_show_error(MMAP_FAILED, -1));
+	return (1);
+}
+
 /**
  * @brief Basically sem_open
+ * @param rules The rules struct
  * @param sem Pointer to the semaphore
  * @param name The name of the semaphore
  * @param value Initial value of the semaphore
@@ -24,14 +59,28 @@
  * 	  6 - File owner can read and write
  *    4 - Users in the same group as owner can read
  *    4 - All users can read
+ * With --sem=anon, the name is not used: the next unnamed semaphore
+ * is initialized (process-shared) instead.
  * 
  * @attention
  * Calling sem_unlink before sem_open is to ensure that any
  * existing semphore with the same name is removed before
  * creating a new one.
 */
-int	pl_sem_open(sem_t **sem, char *name, int value)
+int	pl_sem_open(t_rules *rules, sem_t **sem, char *name, int value)
 {
+	t_sem_pool	*pool;
+
+	pool = &rules->sems;
+	if (rules->opts.sem == ANON)
+	{
+		if (pool->used == pool->total)
+			return (pl_show_error(OPEN_SEM_FAILED, 0));
+		*sem = &pool->slots[pool->used++];
+		if (sem_init(*sem, 1, value) != 0)
+			return (pl_show_error(OPEN_SEM_FAILED, 0));
+		return (1);
+	}
 	sem_unlink(name);
 	*sem = sem_open(name, O_CREAT, 0644, value);
 	if (*sem == SEM_FAILED)
@@ -40,33 +89,23 @@ int	pl_sem_open(sem_t **sem, char *name, int value)
 }
 
 /**
- * @brief Open semaphore for all the shared sempahores
- * @param locks The struct that store all the shared semaphores
- * 
- * @details
- * DECLARE_SEM - use to declare the philo's state
- * SIM_SEM - use to check if the simulation end
- * FULL_SEM - check how many philo are full
+ * @brief Release the parent's semaphores, and the table's
+ * @param rules The rules struct
  * 
  * @attention
- * Shall call in parent so that the semaphores could be shared
- * among the child process.
- * 
- * @return
- * 0, if there's an error
- * 1, if everything is a success
+ * Call only once every child is gone.
 */
-int	pl_setup_shared_sem(t_locks *locks)
+void	pl_sem_release(t_rules *rules)
 {
-	if (pl_sem_open(&locks->declare_sem, DECLARE_SEM, 1) == 0)
-		return (0);
-	if (pl_sem_open(&locks->death_sem, DEATH_SEM, 1) == 0)
-		return (0);
-	if (pl_sem_open(&locks->sim_sem, SIM_SEM, 0) == 0)
-		return (0);
-	if (pl_sem_open(&locks->full_sem, FULL_SEM, 0) == 0)
-		return (0);
-	return (1);
+	if (rules->table != NULL)
+		munmap(rules->table, rules->table->size);
+	if (rules->opts.sem == ANON)
+	{
+		munmap(rules->sems.slots, rules->sems.size);
+		return ;
+	}
+	sem_close(rules->forks);
+	sem_close(rules->gate);
 }
 
 /**
@@ -76,18 +115,21 @@ int	pl_setup_shared_sem(t_locks *locks)
  * 
  * @attention
  * The name of the semaphore is unique for each philo to
- * prevent every philo accidentally use the same one.
+ * prevent every philo accidentally use the same one. Unnamed
+ * semaphores (--sem=anon) need no name.
 */
 int	pl_setup_philo_sem(t_philo *philo)
 {
 	char	*id;
 	char	*sem_name;
+	int		ok;
 
+	if (philo->rules->opts.sem == ANON)
+		return (pl_sem_open(philo->rules, &philo->last_ate_sem, NULL, 1));
 	id = ft_itoa(philo->id + 1);
 	sem_name = ft_strjoin(LAST_ATE_SEM, id);
 	free(id);
-	if (pl_sem_open(&philo->last_ate_sem, sem_name, 1) == 0)
-		return (0);
+	ok = pl_sem_open(philo->rules, &philo->last_ate_sem, sem_name, 1);
 	free(sem_name);
-	return (1);
+	return (ok);
 }
@@ -0,0 +1,148 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_serve.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:50:44 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:08:18 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Map the board and its semaphores in memory shared with the
+ *        warm philos
+ * @param rules The rules struct
+ * @param total Number of warm philos
+ *
+ * @details
+ * The semaphores are unnamed and process-shared (sem_init with pshared
+ * set): they live in the mapping, nothing to open or unlink by name.
+ *
+ * @return 1 if the board is ready. 0 if there's an error.
+*/
+static int	pl_board_init(t_rules *rules, int total)
+{
+	int		i;
+	size_t	size;
+	t_board	*board;
+
+	size = sizeof(t_board) + sizeof(sem_t) * total * 2;
+	board = mmap(NULL, size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (board == MAP_FAILED)
+		return (pl_show_error(MMAP_FAILED, -1));
+	board->size = size;
+	board->go = (sem_t *)(board + 1);
+	board->wake = board->go + total;
+	atomic_init(&board->over, 0);
+	if (sem_init(&board->idle, 1, 0) != 0)
+		return (pl_show_error(OPEN_SEM_FAILED, -1));
+	i = -1;
+	while (++i < total)
+	{
+		if (sem_init(&board->go[i], 1, 0) != 0
+			|| sem_init(&board->wake[i], 1, 0) != 0)
+			return (pl_show_error(OPEN_SEM_FAILED, -1));
+	}
+	rules->board = board;
+	return (1);
+}
+
+/**
+ * @brief Fork the warm philos, each waits for a run on his go semaphore
+ * @param sim The simulation struct, room for every warm philo
+ *
+ * @return 1 if every philo is forked. 0 if there's an error.
+*/
+static int	pl_serve_spawn(t_simulation *sim)
+{
+	int		i;
+	pid_t	pid;
+
+	i = -1;
+	while (++i < sim->rules->opts.serve)
+	{
+		if (pl_philo_init(sim, &sim->philos[i], i) == 0)
+			return (0);
+		pid = fork();
+		if (pid < 0)
+			return (pl_show_error(FORK_FAILED, -1));
+		if (pid == 0)
+		{
+			setpgid(0, sim->rules->reactor.pgid);
+			pl_rt_child(&sim->philos[i], sim->rules->opts.serve);
+			pl_serve_philo(&sim->philos[i]);
+		}
+		pl_reactor_adopt(&sim->rules->reactor, pid);
+	}
+	return (1);
+}
+
+/**
+ * @brief Set up a server: forks start out all taken, a run puts as many
+ *        on the table as it has philos
+ * @param rules The rules struct
+ *
+ * @return 1 if the server is ready. 0 if there's an error.
+*/
+static int	pl_serve_init(t_rules *rules)
+{
+	t_simulation	sim;
+	int				ok;
+
+	if (pl_sem_init(rules, rules->opts.serve) == 0
+		|| pl_sem_open(rules, &rules->forks, FORK_SEM, 0) == 0
+		|| pl_sem_open(rules, &rules->gate, GATE_SEM, 1) == 0
+		|| pl_table_init(rules, rules->opts.serve) == 0
+		|| pl_board_init(rules, rules->opts.serve) == 0
+		|| pl_reactor_init(&rules->reactor, 1) == 0
+		|| pl_log_init(&rules->log, rules->opts.serve, pl_now(),
+			rules->opts.format) == 0)
+		return (0);
+	sim.rules = rules;
+	sim.philos = malloc(sizeof(t_philo) * rules->opts.serve);
+	if (sim.philos == NULL)
+		return (0);
+	ok = pl_serve_spawn(&sim);
+	free(sim.philos);
+	return (ok);
+}
+
+/**
+ * @brief Serve simulations to a pool of warm philos (--serve=<n>)
+ * @param rules The rules struct, from the arguments if any
+ *
+ * @details
+ * The n philos are forked once and kept waiting between runs, so a run
+ * costs no fork, exec, nor semaphore setup. Each line read from stdin
+ * holds the arguments of a run ("5 800 200 200 [7]"), at most n philos.
+ * Runs are done one after the other, in order, until stdin ends.
+*/
+void	pl_serve(t_rules *rules)
+{
+	char	line[SERVE_LINE];
+	char	*words[SERVE_WORDS];
+	int		total;
+	int		ok;
+
+	if (pl_serve_init(rules) == 0)
+		return ;
+	ok = 1;
+	if (rules->philo_total != 0)
+		ok = pl_serve_run(rules);
+	total = pl_serve_line(line, words);
+	while (ok && total >= 0)
+	{
+		if (total > 0 && pl_parse_rules(total, words, rules))
+			ok = pl_serve_run(rules);
+		total = pl_serve_line(line, words);
+	}
+	pl_reactor_stop(&rules->reactor, rules->opts.serve);
+	munmap(rules->log, rules->log->size);
+	munmap(rules->board, rules->board->size);
+	pl_sem_release(rules);
+}
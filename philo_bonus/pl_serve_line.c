@@ -0,0 +1,78 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_serve_line.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:50:44 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:50:44 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Read a line from stdin, a byte at a time so that nothing past
+ *        the newline is taken from the next run's line
+ * @param line Where to store the line, SERVE_LINE long, the rest is cut
+ *
+ * @return The length of the line, -1 once stdin ends.
+*/
+static int	pl_serve_read(char *line)
+{
+	int		len;
+	char	c;
+	ssize_t	got;
+
+	len = 0;
+	got = read(STDIN_FILENO, &c, 1);
+	while (got == 1 && c != '\n')
+	{
+		if (len < SERVE_LINE - 1)
+			line[len++] = c;
+		got = read(STDIN_FILENO, &c, 1);
+	}
+	line[len] = '\0';
+	if (got != 1 && len == 0)
+		return (-1);
+	return (len);
+}
+
+/**
+ * @brief Split a line into words, in place
+ * @param line The line
+ * @param words Where to store the words, SERVE_WORDS at most
+ *
+ * @return The number of words.
+*/
+static int	pl_serve_split(char *line, char **words)
+{
+	int	total;
+
+	total = 0;
+	while (*line != '\0')
+	{
+		while (*line == ' ' || *line == '\t')
+			*line++ = '\0';
+		if (*line != '\0' && total < SERVE_WORDS)
+			words[total++] = line;
+		while (*line != '\0' && *line != ' ' && *line != '\t')
+			line++;
+	}
+	return (total);
+}
+
+/**
+ * @brief Read the next rule line of a server
+ * @param line Where to store the line, SERVE_LINE long
+ * @param words Where to store its words, SERVE_WORDS at most
+ *
+ * @return The number of words (0 for a blank line), -1 once stdin ends.
+*/
+int	pl_serve_line(char *line, char **words)
+{
+	if (pl_serve_read(line) < 0)
+		return (-1);
+	return (pl_serve_split(line, words));
+}
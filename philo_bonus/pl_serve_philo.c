@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_serve_philo.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:50:44 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:56:14 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Whether a server (--serve) called the current run over
+ * @param rules The simulation rules
+ *
+ * @return 1 if it's over, 0 otherwise (always 0 when not serving).
+*/
+int	pl_over(t_rules *rules)
+{
+	return (rules->board != NULL && atomic_load(&rules->board->over) != 0);
+}
+
+/**
+ * @brief Sleep until an absolute deadline, unless the run is over
+ * @param philo The philo
+ * @param deadline The time to wake up (ticks)
+ *
+ * @details
+ * When not serving, this is pl_sleep_until. A warm philo instead waits
+ * on his wake semaphore, which the server posts to end a run, so that he
+ * doesn't sleep through it. sem_clockwait takes the deadline on the
+ * monotonic clock, same as pl_now: stepping the wall clock can't make
+ * him oversleep or wake early.
+*/
+void	pl_nap(t_philo *philo, t_tick deadline)
+{
+	struct timespec	ts;
+	t_board			*board;
+
+	board = philo->rules->board;
+	if (board == NULL)
+	{
+		pl_sleep_until(deadline, philo->rules->opts.spin);
+		return ;
+	}
+	if (atomic_load(&board->over) != 0)
+		return ;
+	ts.tv_sec = deadline / TICK_S;
+	ts.tv_nsec = deadline % TICK_S;
+	while (sem_clockwait(&board->wake[philo->id], CLOCK_MONOTONIC, &ts) != 0)
+	{
+		if (errno != EINTR)
+			return ;
+	}
+}
+
+/**
+ * @brief A philo ended the simulation: he died or was the last to get
+ *        full, and the log is halted already
+ * @param philo The philo
+ *
+ * @details
+ * The philo exits, which wakes the parent's reactor. A warm philo has
+ * to stay, he tells the server through its eventfd instead.
+*/
+void	pl_philo_done(t_philo *philo)
+{
+	uint64_t	one;
+
+	if (philo->rules->board == NULL)
+		exit(0);
+	one = 1;
+	if (write(philo->rules->reactor.evfd, &one, sizeof(one)) < 0)
+		exit(1);
+}
+
+/**
+ * @brief Get a warm philo ready for the next run
+ * @param philo The philo
+ *
+ * @details
+ * The rules of the run are on the board. A wake up the philo didn't
+ * sleep through last run is still counted by his wake semaphore, drop it.
+*/
+static void	pl_serve_load(t_philo *philo)
+{
+	t_rules	*rules;
+	t_board	*board;
+
+	rules = philo->rules;
+	board = rules->board;
+	rules->start_time = board->start;
+	rules->philo_total = board->philo_total;
+	rules->time_to_die = board->time_to_die;
+	rules->time_to_eat = board->time_to_eat;
+	rules->time_to_sleep = board->time_to_sleep;
+	rules->iteration = board->iteration;
+	philo->meal_count = 0;
+	philo->full = NOTFULL;
+	sem_wait(philo->last_ate_sem);
+	philo->last_ate = board->start;
+	sem_post(philo->last_ate_sem);
+	while (sem_trywait(&board->wake[philo->id]) == 0)
+		;
+}
+
+/**
+ * @brief The life of a warm philo: wait to be seated, dine until the
+ *        server calls the run over, tell it he's idle, again
+ * @param philo The philo
+ *
+ * @attention
+ * Never returns, the server kills its philos when it's done.
+*/
+void	pl_serve_philo(t_philo *philo)
+{
+	pthread_t	monitor;
+	t_board		*board;
+
+	board = philo->rules->board;
+	while (1)
+	{
+		sem_wait(&board->go[philo->id]);
+		pl_serve_load(philo);
+		if (pl_monitor_start(philo, &monitor) == 0)
+			exit(1);
+		pl_dine(philo);
+		pl_monitor_wake(philo);
+		pthread_join(monitor, NULL);
+		sem_post(&board->idle);
+	}
+}
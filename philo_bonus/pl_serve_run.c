@@ -0,0 +1,123 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_serve_run.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:50:44 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:55:05 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Post a semaphore a number of times
+ * @param sem The semaphore
+ * @param count How many times
+*/
+static void	pl_serve_post(sem_t *sem, int count)
+{
+	while (count-- > 0)
+		sem_post(sem);
+}
+
+/**
+ * @brief Put the rules of a run on the board and seat its philos
+ * @param rules The rules of the run
+ *
+ * @return 1 if the run started. 0 if there's an error.
+*/
+static int	pl_serve_start(t_rules *rules)
+{
+	t_board	*board;
+	int		i;
+
+	board = rules->board;
+	board->philo_total = rules->philo_total;
+	board->time_to_die = rules->time_to_die;
+	board->time_to_eat = rules->time_to_eat;
+	board->time_to_sleep = rules->time_to_sleep;
+	board->iteration = rules->iteration;
+	board->start = pl_now();
+	rules->start_time = board->start;
+	pl_log_reset(rules->log, rules->philo_total, board->start);
+	if (rules->table != NULL)
+		pl_table_reset(rules->table, rules->philo_total);
+	if (pl_log_start(rules->log) == 0)
+		return (0);
+	pl_serve_post(rules->forks, rules->philo_total);
+	i = -1;
+	while (++i < rules->philo_total)
+		sem_post(&board->go[i]);
+	return (1);
+}
+
+/**
+ * @brief Call a run over and wait until every philo of it is idle
+ * @param rules The rules of the run
+ *
+ * @details
+ * Spare forks (or turns, --fork=adjacent) get every philo out of
+ * sem_wait, a post of his wake semaphore gets him out of his sleep.
+ * Once they're all idle, the forks left on the table and any late
+ * "done" from the eventfd are dropped, so the next run starts from a
+ * clean table.
+*/
+static void	pl_serve_end(t_rules *rules)
+{
+	t_board		*board;
+	uint64_t	count;
+	int			i;
+
+	board = rules->board;
+	atomic_store(&board->over, 1);
+	pl_serve_post(rules->forks, rules->philo_total);
+	i = -1;
+	while (++i < rules->philo_total)
+	{
+		sem_post(&board->wake[i]);
+		if (rules->table != NULL)
+			sem_post(&rules->table->turn[i]);
+	}
+	i = -1;
+	while (++i < rules->philo_total)
+		sem_wait(&board->idle);
+	pl_log_stop(rules->log);
+	if (rules->opts.format != BIN)
+		write(STDOUT_FILENO, "\n", 1);
+	while (sem_trywait(rules->forks) == 0)
+		;
+	read(rules->reactor.evfd, &count, sizeof(count));
+	atomic_store(&board->over, 0);
+}
+
+/**
+ * @brief Do one run of a server
+ * @param rules The rules of the run
+ *
+ * @details
+ * The run is over when one of its philos is done (see pl_philo_done).
+ * A philo that exits instead has crashed, the server can't go on.
+ * Runs are told apart by a blank line, except in the binary format.
+ *
+ * @return 1 if the server can take the next run, 0 otherwise.
+*/
+int	pl_serve_run(t_rules *rules)
+{
+	if (rules->philo_total < 1 || rules->philo_total > rules->opts.serve)
+	{
+		pl_show_error(TOO_MANY_PHILOS, 0);
+		return (1);
+	}
+	if (pl_serve_start(rules) == 0)
+		return (0);
+	if (pl_reactor_wait(&rules->reactor) == 0)
+	{
+		pl_log_stop(rules->log);
+		return (0);
+	}
+	pl_serve_end(rules);
+	return (1);
+}
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_start.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:16:41 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 23:16:41 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Set up the start line in the logger's shared mapping
+ * @param rules The rules struct, logger mapped
+ * 
+ * @details
+ * A process-shared barrier: every child waits at it, and so does the
+ * parent once it forked them all.
+ * 
+ * @attention
+ * Shall call in parent before forking.
+ * 
+ * @return 1 on success, 0 on error.
+*/
+int	pl_start_init(t_rules *rules)
+{
+	pthread_barrierattr_t	attr;
+	int						ok;
+
+	if (pthread_barrierattr_init(&attr) != 0)
+		return (pl_show_error(BARRIER_FAILED, -1));
+	ok = (pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) == 0
+			&& pthread_barrier_init(&rules->log->start_line, &attr,
+				rules->philo_total + 1) == 0);
+	pthread_barrierattr_destroy(&attr);
+	if (ok == 0)
+		return (pl_show_error(BARRIER_FAILED, -1));
+	return (1);
+}
+
+/**
+ * @brief Wait at the start line, then take the start time the parent
+ *        left in the logger as the philo's last meal
+ * @param philo The philo
+ * 
+ * @attention
+ * Shall call in the child, before his monitor is started.
+*/
+void	pl_start_wait(t_philo *philo)
+{
+	t_rules	*rules;
+
+	rules = philo->rules;
+	pthread_barrier_wait(&rules->log->start_line);
+	rules->start_time = rules->log->start;
+	sem_wait(philo->last_ate_sem);
+	philo->last_ate = rules->start_time;
+	sem_post(philo->last_ate_sem);
+}
+
+/**
+ * @brief Start the simulation: every philo leaves the start line on the
+ *        same tick
+ * @param rules The rules struct, every child forked
+ * 
+ * @details
+ * Children are forked one after the other, a 200 seat table takes a
+ * while. Had each philo started on his own, the last ones would have had
+ * less slack than the first. The parent takes the start time right
+ * before it lets them all go, each philo then starts his monitor.
+*/
+void	pl_start_release(t_rules *rules)
+{
+	rules->start_time = pl_now();
+	rules->log->start = rules->start_time;
+	pthread_barrier_wait(&rules->log->start_line);
+}
@@ -0,0 +1,154 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pl_table.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:55:05 by wricky-t          #+#    #+#             */
+/*   Updated: 2026/10/17 22:55:05 by wricky-t         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * @brief Map the table, if the forks are adjacent (--fork=adjacent)
+ * @param rules The rules struct
+ * @param philo_total Number of philos that will be forked
+ *
+ * @details
+ * Like the board of a server, the semaphores are unnamed and
+ * process-shared: they live in the mapping. The seats start out
+ * SEAT_IDLE, the mapping is zeroed.
+ *
+ * @attention
+ * Shall call in parent before forking.
+ *
+ * @return 1 on success, 0 on error.
+*/
+int	pl_table_init(t_rules *rules, int philo_total)
+{
+	int		i;
+	size_t	size;
+	t_table	*table;
+
+	rules->table = NULL;
+	if (rules->opts.fork != ADJACENT)
+		return (1);
+	size = sizeof(t_table) + (sizeof(sem_t) + sizeof(t_seat)) * philo_total;
+	table = mmap(NULL, size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (table == MAP_FAILED)
+		return (pl_show_error(MMAP_FAILED, -1));
+	table->size = size;
+	table->turn = (sem_t *)(table + 1);
+	table->seats = (t_seat *)(table->turn + philo_total);
+	i = -1;
+	while (++i < philo_total)
+	{
+		if (sem_init(&table->turn[i], 1, 0) != 0)
+			return (pl_show_error(OPEN_SEM_FAILED, -1));
+	}
+	if (sem_init(&table->lock, 1, 1) != 0)
+		return (pl_show_error(OPEN_SEM_FAILED, -1));
+	rules->table = table;
+	return (1);
+}
+
+/**
+ * @brief Clear the table: nobody after his forks, no turn pending
+ * @param table The table
+ * @param philo_total Number of philos
+ *
+ * @attention
+ * Shall call while no philo is at the table (before forking, or between
+ * two runs of a server).
+*/
+void	pl_table_reset(t_table *table, int philo_total)
+{
+	int	i;
+
+	i = -1;
+	while (++i < philo_total)
+	{
+		while (sem_trywait(&table->turn[i]) == 0)
+			;
+		table->seats[i] = SEAT_IDLE;
+	}
+}
+
+/**
+ * @brief Give a hungry philo his forks if neither neighbour eats
+ * @param rules The simulation rules
+ * @param id The philo ID
+ *
+ * @attention
+ * Shall call with the table's lock held. A lone philo has a single
+ * fork, he never gets to eat.
+*/
+static void	pl_table_test(t_rules *rules, int id)
+{
+	t_seat	*seats;
+	int		left;
+	int		right;
+
+	seats = rules->table->seats;
+	left = (id + rules->philo_total - 1) % rules->philo_total;
+	right = (id + 1) % rules->philo_total;
+	if (rules->philo_total > 1 && seats[id] == SEAT_HUNGRY
+		&& seats[left] != SEAT_EATING && seats[right] != SEAT_EATING)
+	{
+		seats[id] = SEAT_EATING;
+		sem_post(&rules->table->turn[id]);
+	}
+}
+
+/**
+ * @brief Take both forks at once, waiting for them if needed
+ * @param philo The philo
+ *
+ * @details
+ * The philo never holds a single fork, so two neighbours can't each
+ * hold one and wait for the other's. A lone philo picks up his single
+ * fork, as he would from the pool, then waits for a turn that only a
+ * server ending the run ever gives.
+*/
+void	pl_table_take(t_philo *philo)
+{
+	t_table	*table;
+
+	table = philo->rules->table;
+	if (philo->rules->philo_total == 1)
+	{
+		pl_declare_state(philo, FORK);
+		sem_wait(&table->turn[philo->id]);
+		return ;
+	}
+	sem_wait(&table->lock);
+	table->seats[philo->id] = SEAT_HUNGRY;
+	pl_table_test(philo->rules, philo->id);
+	sem_post(&table->lock);
+	sem_wait(&table->turn[philo->id]);
+	pl_declare_state(philo, FORK);
+	pl_declare_state(philo, FORK);
+}
+
+/**
+ * @brief Put both forks down, and hand them to a hungry neighbour who
+ *        now has both of his
+ * @param philo The philo
+*/
+void	pl_table_put(t_philo *philo)
+{
+	t_table	*table;
+	int		total;
+
+	table = philo->rules->table;
+	total = philo->rules->philo_total;
+	sem_wait(&table->lock);
+	table->seats[philo->id] = SEAT_IDLE;
+	pl_table_test(philo->rules, (philo->id + total - 1) % total);
+	pl_table_test(philo->rules, (philo->id + 1) % total);
+	sem_post(&table->lock);
+}
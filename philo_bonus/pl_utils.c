@@ -6,59 +6,12 @@
 /*   By: wricky-t <wricky-t@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/02/24 11:10:28 by wricky-t          #+#    #+#             */
-/*   Updated: 2023/03/03 18:21:38 by wricky-t         ###   ########.fr       */
+/*   Updated: 2026/10/17 22:18:21 by wricky-t         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo_bonus.h"
 
-/**
- * @brief Get timestamp
- * 
- * @details
- * Get the current time and minus the target time. Return
- * the value difference.
- * 
- * @attention
- * In my mandatory, I didn't use the struct timeval directly. I convert
- * the time format into time_t because I think that's easier to read.
- * However, this method will cause data race in my bonus part even though
- * I protected all the critical part. I don't understand why and how.
- * Thankfully, Sean the KHONVOUM, went through my code and found this
- * issue. The reason behind this is unknown. It's so bizzare.
-*/
-int	pl_get_timestamp(struct timeval before)
-{
-	struct timeval	now;
-
-	gettimeofday(&now, NULL);
-	return (((now.tv_sec - before.tv_sec) * 1000)
-		+ ((now.tv_usec - before.tv_usec) / 1000));
-}
-
-/**
- * @brief A better usleep
- *
- * @details
- * Through some experiments as well as peer's observation, it seems like
- * usleep is not that accurate in some case. Usleep might "overslept", which
- * makes the timestamp of the program less accurate. Hence, to prevent this
- * situation, the idea is to let usleep to sleep a constant amount of time
- * and check if the program has slept for what's required.
- */
-void	pl_usleep(int sec)
-{
-	struct timeval	start;
-
-	gettimeofday(&start, NULL);
-	while (1)
-	{
-		usleep(500);
-		if (pl_get_timestamp(start) >= sec)
-			break ;
-	}
-}
-
 /**
  * @brief Convert numbers into string
 */